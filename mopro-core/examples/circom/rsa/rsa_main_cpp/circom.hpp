@@ -2,10 +2,10 @@
 #define __CIRCOM_H
 
 #include <map>
-#include <gmp.h>
+#include <atomic>
+#include <exception>
 #include <mutex>
-#include <condition_variable>
-#include <thread>
+#include <sys/mman.h>
 
 #include "fr.hpp"
 
@@ -33,26 +33,58 @@ struct IODefPair {
 
 struct Circom_Circuit {
   //  const char *P;
-  HashSignalInfo* InputHashMap;
-  u64* witness2SignalList;
-  FrElement* circuitConstants;  
+  HashSignalInfo* InputHashMap = nullptr;
+  u64* witness2SignalList = nullptr;
+  FrElement* circuitConstants = nullptr;  
   std::map<u32,IODefPair> templateInsId2IOSignalInfo;
+
+  // zeroCopy: the arrays above point into the .dat data instead of owned
+  // copies. mappedData is the read-only mapping they point into, if the
+  // circuit owns it.
+  bool zeroCopy = false;
+  void* mappedData = nullptr;
+  size_t mappedSize = 0;
+
+  ~Circom_Circuit() {
+    if (!zeroCopy) {
+      delete[] InputHashMap;
+      delete[] witness2SignalList;
+      delete[] circuitConstants;
+    }
+    if (mappedData != nullptr) {
+      munmap(mappedData, mappedSize);
+    }
+  }
 };
 
 
+// Completion of a task run by the context's thread pool. Consumers wait on
+// it through Circom_ThreadPool::wait(), which also rethrows the task's
+// exception. A future that was never submitted counts as done.
+struct Circom_Future {
+  std::atomic<bool> pending;
+  std::exception_ptr error;
+};
+
+// Static component name emitted with the generated circuit. Components only
+// keep the id of their entry plus their position, and traces are built
+// from the table when an assert fails.
+struct Circom_ComponentName {
+  const char* name;
+  u32 nDimensions;
+  const u32* dimensions;
+};
+
 struct Circom_Component {
   u32 templateId;
   u64 signalStart;
   u32 inputCounter;
-  std::string templateName;
-  std::string componentName;
+  u32 componentNameId;   // entry in the circuit's component name table
+  u32 componentPosition; // flat index when the component is an array
   u64 idFather; 
   u32* subcomponents = NULL;
   bool* subcomponentsParallel = NULL;
-  bool *outputIsSet = NULL;  //one for each output
-  std::mutex *mutexes = NULL;  //one for each output
-  std::condition_variable *cvs = NULL;
-  std::thread *sbct = NULL;//subcomponent threads
+  Circom_Future *sbct = NULL; //subcomponent runs submitted to the thread pool
 };
 
 /*
@@ -81,5 +113,7 @@ uint get_size_of_input_hashmap();
 uint get_size_of_witness();
 uint get_size_of_constants();
 uint get_size_of_io_map();
+const char* get_template_name(uint templateId);
+const Circom_ComponentName* get_component_name(uint nameId);
 
 #endif  // __CIRCOM_H
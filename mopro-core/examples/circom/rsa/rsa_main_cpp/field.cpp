@@ -0,0 +1,7 @@
+#include "field.hpp"
+
+constexpr uint64_t Bls12381FrParams::q[4];
+constexpr uint64_t Bls12381FrParams::R2[4];
+
+constexpr uint64_t GoldilocksParams::q[1];
+constexpr uint64_t GoldilocksParams::R2[1];
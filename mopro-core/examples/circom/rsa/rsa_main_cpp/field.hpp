@@ -0,0 +1,574 @@
+#ifndef __FIELD_H
+#define __FIELD_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <ctype.h>
+
+// Prime field in Montgomery form, fixed at compile time by a Params type:
+//
+//   struct Params {
+//       static const int N64 = ...;                   // 64-bit limbs
+//       static const int MaxBits = ...;               // bits of the modulus
+//       static constexpr uint64_t q[N64] = {...};     // modulus, low limb first
+//       static constexpr uint64_t R2[N64] = {...};    // 2^(128*N64) mod q
+//   };
+//
+// The arrays need an out-of-line definition in one translation unit, as any
+// static constexpr array member does before C++17. The arithmetic lives in
+// FieldKernels<Params>, chosen by limb count: one limb runs on a single
+// 64x64 multiplication, four limbs use an unrolled multiplication, others
+// a generic loop. A field can also specialize FieldKernels entirely, as
+// fr.hpp does to run BN254 on the Fr_raw* backend.
+
+typedef unsigned __int128 Field_u128;
+
+// -q^-1 mod 2^64 by Newton iteration; each step doubles the correct bits
+// and q*q = 1 mod 8 gives three to start with.
+constexpr uint64_t Field_invStep(uint64_t q0, uint64_t x, int steps) {
+    return steps == 0 ? x : Field_invStep(q0, x * (2 - q0 * x), steps - 1);
+}
+
+constexpr uint64_t Field_negInv64(uint64_t q0) {
+    return (uint64_t)0 - Field_invStep(q0, q0, 5);
+}
+
+template <class Params>
+struct FieldKernelsGeneric {
+    static const int N = Params::N64;
+    static constexpr uint64_t np = Field_negInv64(Params::q[0]);
+
+    static inline uint64_t addCarry(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+        uint64_t carry = 0;
+        for (int i=0; i<N; i++) {
+            Field_u128 s = (Field_u128)a[i] + b[i] + carry;
+            r[i] = (uint64_t)s;
+            carry = (uint64_t)(s >> 64);
+        }
+        return carry;
+    }
+
+    static inline uint64_t subBorrow(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+        uint64_t borrow = 0;
+        for (int i=0; i<N; i++) {
+            Field_u128 d = (Field_u128)a[i] - b[i] - borrow;
+            r[i] = (uint64_t)d;
+            borrow = (uint64_t)(d >> 64) & 1;
+        }
+        return borrow;
+    }
+
+    static inline bool geqQ(const uint64_t *a) {
+        for (int i=N-1; i>=0; i--) {
+            if (a[i] != Params::q[i]) return a[i] > Params::q[i];
+        }
+        return true;
+    }
+
+    static inline void copy(uint64_t *r, const uint64_t *a) {
+        for (int i=0; i<N; i++) r[i] = a[i];
+    }
+
+    static inline void add(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+        uint64_t carry = addCarry(r, a, b);
+        if (carry || geqQ(r)) subBorrow(r, r, Params::q);
+    }
+
+    static inline void sub(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+        if (subBorrow(r, a, b)) addCarry(r, r, Params::q);
+    }
+
+    static inline void neg(uint64_t *r, const uint64_t *a) {
+        if (isZero(a)) {
+            for (int i=0; i<N; i++) r[i] = 0;
+        } else {
+            subBorrow(r, Params::q, a);
+        }
+    }
+
+    // CIOS Montgomery multiplication with two extra words, valid for any q.
+    static void mul(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+        uint64_t t[N+2];
+        for (int i=0; i<N+2; i++) t[i] = 0;
+        for (int i=0; i<N; i++) {
+            uint64_t carry = 0;
+            for (int j=0; j<N; j++) {
+                Field_u128 p = (Field_u128)a[j] * b[i] + t[j] + carry;
+                t[j] = (uint64_t)p;
+                carry = (uint64_t)(p >> 64);
+            }
+            Field_u128 s = (Field_u128)t[N] + carry;
+            t[N] = (uint64_t)s;
+            t[N+1] = (uint64_t)(s >> 64);
+
+            uint64_t m = t[0] * np;
+            Field_u128 p = (Field_u128)m * Params::q[0] + t[0];
+            carry = (uint64_t)(p >> 64);
+            for (int j=1; j<N; j++) {
+                p = (Field_u128)m * Params::q[j] + t[j] + carry;
+                t[j-1] = (uint64_t)p;
+                carry = (uint64_t)(p >> 64);
+            }
+            s = (Field_u128)t[N] + carry;
+            t[N-1] = (uint64_t)s;
+            t[N] = t[N+1] + (uint64_t)(s >> 64);
+        }
+        if (t[N] || geqQ(t)) subBorrow(t, t, Params::q);
+        copy(r, t);
+    }
+
+    static inline bool isZero(const uint64_t *a) {
+        uint64_t acc = 0;
+        for (int i=0; i<N; i++) acc |= a[i];
+        return acc == 0;
+    }
+
+    static inline bool eq(const uint64_t *a, const uint64_t *b) {
+        for (int i=0; i<N; i++) {
+            if (a[i] != b[i]) return false;
+        }
+        return true;
+    }
+};
+
+template <class Params>
+constexpr uint64_t FieldKernelsGeneric<Params>::np;
+
+// Generic limb counts. The derived kernels below reuse everything but mul.
+template <class Params, int N = Params::N64>
+struct FieldKernels : FieldKernelsGeneric<Params> {
+    typedef FieldKernelsGeneric<Params> G;
+
+    static inline void square(uint64_t *r, const uint64_t *a) { G::mul(r, a, a); }
+    static inline void toMontgomery(uint64_t *r, const uint64_t *a) { G::mul(r, a, Params::R2); }
+    static inline void fromMontgomery(uint64_t *r, const uint64_t *a) {
+        uint64_t one[N] = {1};
+        G::mul(r, a, one);
+    }
+};
+
+// Single-limb fields such as Goldilocks: one 64x64->128 product and one
+// reduction step.
+template <class Params>
+struct FieldKernels<Params, 1> : FieldKernelsGeneric<Params> {
+    typedef FieldKernelsGeneric<Params> G;
+
+    static inline uint64_t reduce(Field_u128 t) {
+        // t + m*q is a multiple of 2^64; its low half carries out unless t's
+        // low half is zero. The result is below 2q, which can exceed 2^64.
+        uint64_t m = (uint64_t)t * G::np;
+        Field_u128 mq = (Field_u128)m * Params::q[0];
+        Field_u128 u = (t >> 64) + (mq >> 64) + ((uint64_t)t != 0);
+        if (u >= Params::q[0]) u -= Params::q[0];
+        return (uint64_t)u;
+    }
+
+    static inline void add(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+        Field_u128 s = (Field_u128)a[0] + b[0];
+        if (s >= Params::q[0]) s -= Params::q[0];
+        r[0] = (uint64_t)s;
+    }
+
+    static inline void sub(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+        r[0] = a[0] >= b[0] ? a[0] - b[0] : a[0] + (Params::q[0] - b[0]);
+    }
+
+    static inline void neg(uint64_t *r, const uint64_t *a) {
+        r[0] = a[0] ? Params::q[0] - a[0] : 0;
+    }
+
+    static inline void mul(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+        r[0] = reduce((Field_u128)a[0] * b[0]);
+    }
+
+    static inline void square(uint64_t *r, const uint64_t *a) { mul(r, a, a); }
+    static inline void toMontgomery(uint64_t *r, const uint64_t *a) { mul(r, a, Params::R2); }
+    static inline void fromMontgomery(uint64_t *r, const uint64_t *a) { r[0] = reduce(a[0]); }
+};
+
+// Four limbs: when the top limb of q is below 2^63 - 1 the running value of
+// the CIOS loop fits in four words, which saves the carry words and lets
+// the loop unroll.
+template <class Params>
+struct FieldKernels<Params, 4> : FieldKernelsGeneric<Params> {
+    typedef FieldKernelsGeneric<Params> G;
+
+    static void mul(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+        if (!(Params::q[3] < 0x7fffffffffffffffULL)) {
+            G::mul(r, a, b);
+            return;
+        }
+        uint64_t t0 = 0, t1 = 0, t2 = 0, t3 = 0;
+        for (int i=0; i<4; i++) {
+            uint64_t bi = b[i];
+            Field_u128 p = (Field_u128)a[0] * bi + t0;
+            t0 = (uint64_t)p;
+            uint64_t A = (uint64_t)(p >> 64);
+            uint64_t m = t0 * G::np;
+            Field_u128 c = (Field_u128)m * Params::q[0] + t0;
+            uint64_t C = (uint64_t)(c >> 64);
+
+            p = (Field_u128)a[1] * bi + t1 + A;
+            t1 = (uint64_t)p; A = (uint64_t)(p >> 64);
+            c = (Field_u128)m * Params::q[1] + t1 + C;
+            t0 = (uint64_t)c; C = (uint64_t)(c >> 64);
+
+            p = (Field_u128)a[2] * bi + t2 + A;
+            t2 = (uint64_t)p; A = (uint64_t)(p >> 64);
+            c = (Field_u128)m * Params::q[2] + t2 + C;
+            t1 = (uint64_t)c; C = (uint64_t)(c >> 64);
+
+            p = (Field_u128)a[3] * bi + t3 + A;
+            t3 = (uint64_t)p; A = (uint64_t)(p >> 64);
+            c = (Field_u128)m * Params::q[3] + t3 + C;
+            t2 = (uint64_t)c; C = (uint64_t)(c >> 64);
+
+            t3 = C + A;
+        }
+        uint64_t t[4] = {t0, t1, t2, t3};
+        if (G::geqQ(t)) G::subBorrow(t, t, Params::q);
+        G::copy(r, t);
+    }
+
+    static inline void square(uint64_t *r, const uint64_t *a) { mul(r, a, a); }
+    static inline void toMontgomery(uint64_t *r, const uint64_t *a) { mul(r, a, Params::R2); }
+    static inline void fromMontgomery(uint64_t *r, const uint64_t *a) {
+        uint64_t one[4] = {1, 0, 0, 0};
+        mul(r, a, one);
+    }
+};
+
+template <class Params>
+class Field {
+
+    typedef FieldKernels<Params> K;
+
+public:
+    const static int N64 = Params::N64;
+    const static int MaxBits = Params::MaxBits;
+
+
+    struct Element {
+        uint64_t v[N64];
+    };
+
+private:
+    Element fZero;
+    Element fOne;
+    Element fNegOne;
+
+public:
+
+    Field() {
+        set(fZero, 0);
+        set(fOne, 1);
+        neg(fNegOne, fOne);
+    }
+
+    const Element &zero() { return fZero; };
+    const Element &one() { return fOne; };
+    const Element &negOne() { return fNegOne; };
+    Element set(int value) { Element r; set(r, value); return r; };
+    void set(Element &r, int value);
+
+    void fromString(Element &r, const std::string &n, uint32_t radix = 10);
+    std::string toString(const Element &a, uint32_t radix = 10);
+
+    void inline copy(Element &r, const Element &a) { r = a; };
+    void inline swap(Element &a, Element &b) { Element t = a; a = b; b = t; };
+    void inline add(Element &r, const Element &a, const Element &b) { K::add(r.v, a.v, b.v); };
+    void inline sub(Element &r, const Element &a, const Element &b) { K::sub(r.v, a.v, b.v); };
+    void inline mul(Element &r, const Element &a, const Element &b) { K::mul(r.v, a.v, b.v); };
+
+    Element inline add(const Element &a, const Element &b) { Element r; K::add(r.v, a.v, b.v); return r;};
+    Element inline sub(const Element &a, const Element &b) { Element r; K::sub(r.v, a.v, b.v); return r;};
+    Element inline mul(const Element &a, const Element &b) { Element r; K::mul(r.v, a.v, b.v); return r;};
+
+    Element inline neg(const Element &a) { Element r; K::neg(r.v, a.v); return r; };
+    Element inline square(const Element &a) { Element r; K::square(r.v, a.v); return r; };
+
+    Element inline add(int a, const Element &b) { return add(set(a), b);};
+    Element inline sub(int a, const Element &b) { return sub(set(a), b);};
+    Element inline mul(int a, const Element &b) { return mul(set(a), b);};
+
+    Element inline add(const Element &a, int b) { return add(a, set(b));};
+    Element inline sub(const Element &a, int b) { return sub(a, set(b));};
+    Element inline mul(const Element &a, int b) { return mul(a, set(b));};
+
+    void inline mul1(Element &r, const Element &a, uint64_t b) { Element e = {{b}}; K::mul(r.v, a.v, e.v); };
+    void inline neg(Element &r, const Element &a) { K::neg(r.v, a.v); };
+    void inline square(Element &r, const Element &a) { K::square(r.v, a.v); };
+    void inv(Element &r, const Element &a);
+    void batchInv(Element *r, const Element *a, uint32_t n);
+    void div(Element &r, const Element &a, const Element &b);
+    void exp(Element &r, const Element &base, uint8_t* scalar, unsigned int scalarSize);
+
+    void inline toMontgomery(Element &r, const Element &a) { K::toMontgomery(r.v, a.v); };
+    void inline fromMontgomery(Element &r, const Element &a) { K::fromMontgomery(r.v, a.v); };
+    int inline eq(const Element &a, const Element &b) { return K::eq(a.v, b.v); };
+    int inline isZero(const Element &a) { return K::isZero(a.v); };
+
+    int toRprBE(const Element &element, uint8_t *data, int bytes);
+    int fromRprBE(Element &element, const uint8_t *data, int bytes);
+
+    int bytes ( void ) { return N64 * 8; };
+
+    void fromUI(Element &r, unsigned long int v);
+
+    static Field field;
+
+};
+
+template <class Params>
+Field<Params> Field<Params>::field;
+
+template <class Params>
+void Field<Params>::set(Element &r, int value) {
+    Element a = {{0}};
+    a.v[0] = value < 0 ? (uint64_t)(-(int64_t)value) : (uint64_t)value;
+    K::toMontgomery(r.v, a.v);
+    if (value < 0) K::neg(r.v, r.v);
+}
+
+template <class Params>
+void Field<Params>::fromUI(Element &r, unsigned long int v) {
+    Element a = {{0}};
+    a.v[0] = v;
+    K::toMontgomery(r.v, a.v);
+}
+
+static inline int Field_digitValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+    return -1;
+}
+
+// Accepts what mpz_set_str() does for bases 2 to 36: an optional minus
+// sign, white space anywhere, and with radix 0 a 0x, 0b or 0 prefix picks
+// the base. Digits are gathered in chunks that fit in 64 bits and folded
+// in with two Montgomery multiplications per chunk. An invalid string
+// reads as zero.
+template <class Params>
+void Field<Params>::fromString(Element &r, const std::string &s, uint32_t radix) {
+    const char *p = s.c_str();
+    while (isspace((unsigned char)*p)) p++;
+    bool negative = false;
+    if (*p == '-') {
+        negative = true;
+        p++;
+    }
+    while (isspace((unsigned char)*p)) p++;
+    if (radix == 0) {
+        radix = 10;
+        if (p[0] == '0') {
+            if (p[1] == 'x' || p[1] == 'X') {
+                radix = 16;
+                p += 2;
+            } else if (p[1] == 'b' || p[1] == 'B') {
+                radix = 2;
+                p += 2;
+            } else {
+                radix = 8;
+            }
+        }
+    }
+
+    Element acc = Element();
+    uint64_t chunk = 0;
+    uint64_t scale = 1;
+    const uint64_t maxScale = UINT64_MAX / radix;
+    for (;; p++) {
+        if (*p && isspace((unsigned char)*p)) continue;
+        if (!*p || scale > maxScale) {
+            // acc = acc*scale + chunk
+            Element m = Element(), c = Element();
+            m.v[0] = scale;
+            c.v[0] = chunk;
+            K::toMontgomery(m.v, m.v);
+            K::toMontgomery(c.v, c.v);
+            K::mul(acc.v, acc.v, m.v);
+            K::add(acc.v, acc.v, c.v);
+            chunk = 0;
+            scale = 1;
+            if (!*p) break;
+        }
+        int d = Field_digitValue(*p);
+        if (d < 0 || (uint32_t)d >= radix) {
+            r = Element();
+            return;
+        }
+        chunk = chunk*radix + d;
+        scale *= radix;
+    }
+
+    if (negative) K::neg(acc.v, acc.v);
+    r = acc;
+}
+
+// Canonical value in bases 2 to 36, lower-case digits as mpz_get_str().
+template <class Params>
+std::string Field<Params>::toString(const Element &a, uint32_t radix) {
+    if (radix < 2 || radix > 36) radix = 10;
+    Element n;
+    K::fromMontgomery(n.v, a.v);
+
+    // Peel off as many digits per division as fit in 64 bits.
+    uint64_t big = radix;
+    int bigDigits = 1;
+    while (big <= UINT64_MAX / radix) {
+        big *= radix;
+        bigDigits++;
+    }
+
+    std::string out;
+    for (;;) {
+        uint64_t rem = 0;
+        bool zero = true;
+        for (int i=N64-1; i>=0; i--) {
+            Field_u128 cur = ((Field_u128)rem << 64) | n.v[i];
+            n.v[i] = (uint64_t)(cur / big);
+            rem = (uint64_t)(cur % big);
+            if (n.v[i]) zero = false;
+        }
+        for (int i=0; i<bigDigits && (rem || !zero); i++) {
+            out.push_back("0123456789abcdefghijklmnopqrstuvwxyz"[rem % radix]);
+            rem /= radix;
+        }
+        if (zero) break;
+    }
+    if (out.empty()) out.push_back('0');
+    return std::string(out.rbegin(), out.rend());
+}
+
+// a^(q-2) by square and multiply, so inv(0) = 0. A field with a faster
+// inversion specializes this member, as fr.cpp does for BN254.
+template <class Params>
+void Field<Params>::inv(Element &r, const Element &a) {
+    uint64_t e[N64];
+    uint64_t borrow = 2;
+    for (int i=0; i<N64; i++) {
+        e[i] = Params::q[i] - borrow;
+        borrow = Params::q[i] < borrow;
+    }
+    Element base = a;
+    Element acc = fOne;
+    for (int i=N64*64-1; i>=0; i--) {
+        square(acc, acc);
+        if ((e[i>>6] >> (i & 63)) & 1) mul(acc, acc, base);
+    }
+    r = acc;
+}
+
+template <class Params>
+void Field<Params>::div(Element &r, const Element &a, const Element &b) {
+    Element tmp;
+    inv(tmp, b);
+    mul(r, a, tmp);
+}
+
+// Montgomery's trick: one inversion of the product of all non-zero inputs,
+// then three multiplications per element. Zero inputs are skipped in the
+// product and invert to zero, as in inv(). r may alias a.
+template <class Params>
+void Field<Params>::batchInv(Element *r, const Element *a, uint32_t n) {
+    if (n == 0) return;
+    static thread_local std::vector<Element> prefix;
+    prefix.resize(n);
+
+    Element acc;
+    copy(acc, fOne);
+    for (uint32_t i=0; i<n; i++) {
+        copy(prefix[i], acc);
+        if (!isZero(a[i])) mul(acc, acc, a[i]);
+    }
+
+    inv(acc, acc);
+
+    for (uint32_t i=n; i-- > 0;) {
+        if (isZero(a[i])) {
+            copy(r[i], fZero);
+            continue;
+        }
+        Element ai;
+        copy(ai, a[i]);
+        mul(r[i], acc, prefix[i]);
+        mul(acc, acc, ai);
+    }
+}
+
+template <class Params>
+void Field<Params>::exp(Element &r, const Element &base, uint8_t* scalar, unsigned int scalarSize) {
+    bool oneFound = false;
+    Element copyBase;
+    copy(copyBase, base);
+    for (int i=scalarSize*8-1; i>=0; i--) {
+        bool bit = scalar[i>>3] & (1 << (i & 0x7));
+        if (!oneFound) {
+            if (!bit) continue;
+            copy(r, copyBase);
+            oneFound = true;
+            continue;
+        }
+        square(r, r);
+        if (bit) {
+            mul(r, r, copyBase);
+        }
+    }
+    if (!oneFound) {
+        copy(r, fOne);
+    }
+}
+
+// Big-endian, always N64*8 bytes.
+template <class Params>
+int Field<Params>::toRprBE(const Element &element, uint8_t *data, int bytes)
+{
+    if (bytes < N64 * 8) {
+      return -(N64 * 8);
+    }
+    Element tmp;
+    fromMontgomery(tmp, element);
+    for (int i=0; i<N64*8; i++) {
+        data[i] = (uint8_t)(tmp.v[N64 - 1 - i/8] >> (56 - 8*(i%8)));
+    }
+    return N64 * 8;
+}
+
+template <class Params>
+int Field<Params>::fromRprBE(Element &element, const uint8_t *data, int bytes)
+{
+    if (bytes < N64 * 8) {
+      return -(N64 * 8);
+    }
+    Element tmp = {{0}};
+    for (int i=0; i<N64*8; i++) {
+        tmp.v[N64 - 1 - i/8] |= (uint64_t)data[i] << (56 - 8*(i%8));
+    }
+    toMontgomery(element, tmp);
+    return N64 * 8;
+}
+
+
+// BLS12-381 scalar field.
+struct Bls12381FrParams {
+    static const int N64 = 4;
+    static const int MaxBits = 255;
+    static constexpr uint64_t q[4] = {0xffffffff00000001,0x53bda402fffe5bfe,0x3339d80809a1d805,0x73eda753299d7d48};
+    static constexpr uint64_t R2[4] = {0xc999e990f3f29c6d,0x2b6cedcb87925c23,0x05d314967254398f,0x0748d9d99f59ff11};
+};
+
+// Goldilocks, 2^64 - 2^32 + 1.
+struct GoldilocksParams {
+    static const int N64 = 1;
+    static const int MaxBits = 64;
+    static constexpr uint64_t q[1] = {0xffffffff00000001};
+    static constexpr uint64_t R2[1] = {0xfffffffe00000001};
+};
+
+typedef Field<Bls12381FrParams> Bls12381Fr;
+typedef Field<GoldilocksParams> GoldilocksField;
+
+#endif // __FIELD_H
@@ -1,321 +1,553 @@
 #include "fr.hpp"
 #include <stdio.h>
 #include <stdlib.h>
-#include <gmp.h>
+#include <string.h>
 #include <assert.h>
 #include <string>
+#include <vector>
+
+
+// Longest number str2elementFast() parses: 78 digits in any base up to 16
+// fit in its ten 32-bit limbs.
+#define FR_STR2ELEMENT_MAX_DIGITS 78
+
+// Fast path of Fr_str2element() for the constants in generated code. Digits
+// are accumulated in chunks that fit in 32 bits into a 320-bit value, which
+// is then reduced while it is turned into Montgomery form. Returns false for
+// anything it does not handle (other bases, whitespace, longer numbers) so
+// that the caller can fall back to the general parser.
+static bool str2elementFast(PFrElement pE, char const *s, uint base) {
+    uint chunkDigits;
+    switch (base) {
+        case 2: chunkDigits = 31; break;
+        case 8: chunkDigits = 10; break;
+        case 10: chunkDigits = 9; break;
+        case 16: chunkDigits = 7; break;
+        default: return false;
+    }
 
+    bool neg = false;
+    if (*s == '-') {
+        neg = true;
+        s++;
+    }
 
-static mpz_t q;
-static mpz_t zero;
-static mpz_t one;
-static mpz_t mask;
-static size_t nBits;
-static bool initialized = false;
-
-
-void Fr_toMpz(mpz_t r, PFrElement pE) {
-    FrElement tmp;
-    Fr_toNormal(&tmp, pE);
-    if (!(tmp.type & Fr_LONG)) {
-        mpz_set_si(r, tmp.shortVal);
-        if (tmp.shortVal<0) {
-            mpz_add(r, r, q);
+    uint32_t v[10] = {0};
+    uint nLimbs = 0;
+    uint nDigits = 0;
+    while (*s) {
+        uint32_t chunk = 0;
+        uint32_t scale = 1;
+        for (uint i = 0; i < chunkDigits && *s; i++, s++) {
+            char c = *s;
+            uint32_t d;
+            if (c >= '0' && c <= '9') d = c - '0';
+            else if (c >= 'a' && c <= 'f') d = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') d = c - 'A' + 10;
+            else return false;
+            if (d >= base) return false;
+            if (++nDigits > FR_STR2ELEMENT_MAX_DIGITS) return false;
+            chunk = chunk*base + d;
+            scale *= base;
         }
-    } else {
-        mpz_import(r, Fr_N64, -1, 8, -1, 0, (const void *)tmp.longVal);
+        uint64_t carry = chunk;
+        for (uint i = 0; i < nLimbs; i++) {
+            carry += (uint64_t)v[i]*scale;
+            v[i] = (uint32_t)carry;
+            carry >>= 32;
+        }
+        if (carry) v[nLimbs++] = (uint32_t)carry;
     }
-}
+    if (nDigits == 0) return false;
+
+    uint64_t w[5];
+    for (int i = 0; i < 5; i++) w[i] = ((uint64_t)v[2*i+1] << 32) | v[2*i];
 
-void Fr_fromMpz(PFrElement pE, mpz_t v) {
-    if (mpz_fits_sint_p(v)) {
+    if (w[1] == 0 && w[2] == 0 && w[3] == 0 && w[4] == 0 && w[0] <= 0x7FFFFFFF && (!neg || w[0] == 0)) {
         pE->type = Fr_SHORT;
-        pE->shortVal = mpz_get_si(v);
-    } else {
-        pE->type = Fr_LONG;
-        for (int i=0; i<Fr_N64; i++) pE->longVal[i] = 0;
-        mpz_export((void *)(pE->longVal), NULL, -1, 8, -1, 0, v);
+        pE->shortVal = (int32_t)w[0];
+        return true;
     }
-}
 
+    // With R = 2^256, w*R = lo*R + hi*R^3/R, and both Montgomery products
+    // come out reduced.
+    FrRawElement lo = {w[0], w[1], w[2], w[3]};
+    FrRawElement r;
+    Fr_rawToMontgomery(r, lo);
+    if (w[4]) {
+        FrRawElement hi = {w[4], 0, 0, 0};
+        FrRawElement hiR;
+        Fr_rawMMul(hiR, hi, Fr_rawR3);
+        Fr_rawAdd(r, r, hiR);
+    }
+    if (neg) Fr_rawNeg(r, r);
 
-bool Fr_init() {
-    if (initialized) return false;
-    initialized = true;
-    mpz_init(q);
-    mpz_import(q, Fr_N64, -1, 8, -1, 0, (const void *)Fr_q.longVal);
-    mpz_init_set_ui(zero, 0);
-    mpz_init_set_ui(one, 1);
-    nBits = mpz_sizeinbase (q, 2);
-    mpz_init(mask);
-    mpz_mul_2exp(mask, one, nBits);
-    mpz_sub(mask, mask, one);
+    pE->type = Fr_LONGMONTGOMERY;
+    pE->shortVal = 0;
+    for (int i=0; i<Fr_N64; i++) pE->longVal[i] = r[i];
     return true;
 }
 
 void Fr_str2element(PFrElement pE, char const *s, uint base) {
-    mpz_t mr;
-    mpz_init_set_str(mr, s, base);
-    mpz_fdiv_r(mr, mr, q);
-    Fr_fromMpz(pE, mr);
-    mpz_clear(mr);
+    if (str2elementFast(pE, s, base)) return;
+    RawFr::Element r;
+    RawFr::field.fromString(r, s, base);
+    pE->type = Fr_LONGMONTGOMERY;
+    pE->shortVal = 0;
+    for (int i=0; i<Fr_N64; i++) pE->longVal[i] = r.v[i];
 }
 
-char *Fr_element2str(PFrElement pE) {
-    FrElement tmp;
-    mpz_t r;
-    if (!(pE->type & Fr_LONG)) {
-        if (pE->shortVal>=0) {
-            char *r = new char[32];
-            sprintf(r, "%d", pE->shortVal);
-            return r;
+// Canonical value of a in [0, q) as plain limbs.
+static void toCanonical(FrRawElement r, PFrElement a) {
+    if (!(a->type & Fr_LONG)) {
+        if (a->shortVal >= 0) {
+            r[0] = a->shortVal;
+            r[1] = r[2] = r[3] = 0;
         } else {
-            mpz_init_set_si(r, pE->shortVal);
-            mpz_add(r, r, q);
+            FrRawElement v = {(uint64_t)-(int64_t)a->shortVal, 0, 0, 0};
+            Fr_rawSub(r, Fr_rawq, v);
         }
+        return;
+    }
+    FrElement tmp;
+    Fr_toNormal(&tmp, a);
+    for (int i=0; i<Fr_N64; i++) r[i] = tmp.longVal[i];
+}
+
+// Stores v < q as short when it fits, else long in normal form.
+static void setCanonical(PFrElement r, const FrRawElement v) {
+    if (!v[1] && !v[2] && !v[3] && v[0] <= INT32_MAX) {
+        r->type = Fr_SHORT;
+        r->shortVal = (int32_t)v[0];
     } else {
-        Fr_toNormal(&tmp, pE);
-        mpz_init(r);
-        mpz_import(r, Fr_N64, -1, 8, -1, 0, (const void *)tmp.longVal);
+        r->type = Fr_LONG;
+        r->shortVal = 0;
+        for (int i=0; i<Fr_N64; i++) r->longVal[i] = v[i];
+    }
+}
+
+// Decimal string of the canonical value, negative shorts included. The
+// caller releases it with free().
+char *Fr_element2str(PFrElement pE) {
+    if (!(pE->type & Fr_LONG) && pE->shortVal >= 0) {
+        char *r = (char *)malloc(32);
+        snprintf(r, 32, "%d", pE->shortVal);
+        return r;
+    }
+    FrRawElement v;
+    RawFr::Element e;
+    toCanonical(v, pE);
+    Fr_rawToMontgomery(e.v, v);
+    return strdup(RawFr::field.toString(e).c_str());
+}
+
+// Integer division of 256-bit values, quo = a / b and rem = a % b, by
+// Knuth's algorithm D on 64-bit limbs, with shortcuts for power-of-two and
+// single-limb divisors. b must not be zero.
+static void rawDivMod(FrRawElement quo, FrRawElement rem, const FrRawElement a, const FrRawElement b) {
+    typedef unsigned __int128 u128;
+
+    int n = Fr_N64;
+    while (n > 0 && !b[n-1]) n--;
+    assert(n > 0);
+
+    bool pow2 = (b[n-1] & (b[n-1] - 1)) == 0;
+    for (int i=0; i<n-1 && pow2; i++) pow2 = !b[i];
+    if (pow2) {
+        int k = (n-1)*64 + __builtin_ctzll(b[n-1]);
+        int words = k >> 6, bits = k & 63;
+        for (int i=0; i<Fr_N64; i++) {
+            uint64_t lo = i + words < Fr_N64 ? a[i+words] : 0;
+            uint64_t hi = i + words + 1 < Fr_N64 ? a[i+words+1] : 0;
+            quo[i] = bits ? (lo >> bits) | (hi << (64 - bits)) : lo;
+            if (i < words) {
+                rem[i] = a[i];
+            } else if (i == words) {
+                rem[i] = a[i] & ((1ULL << bits) - 1);
+            } else {
+                rem[i] = 0;
+            }
+        }
+        return;
+    }
+
+    if (n == 1) {
+        uint64_t d = b[0];
+        uint64_t r = 0;
+        for (int i=Fr_N64-1; i>=0; i--) {
+            u128 cur = ((u128)r << 64) | a[i];
+            quo[i] = (uint64_t)(cur / d);
+            r = (uint64_t)(cur % d);
+        }
+        rem[0] = r;
+        rem[1] = rem[2] = rem[3] = 0;
+        return;
+    }
+
+    // Normalize so that the top limb of the divisor has its high bit set.
+    int s = __builtin_clzll(b[n-1]);
+    uint64_t bn[Fr_N64];
+    uint64_t an[Fr_N64+1];
+    for (int i=n-1; i>0; i--) bn[i] = s ? (b[i] << s) | (b[i-1] >> (64 - s)) : b[i];
+    bn[0] = b[0] << s;
+    an[Fr_N64] = s ? a[Fr_N64-1] >> (64 - s) : 0;
+    for (int i=Fr_N64-1; i>0; i--) an[i] = s ? (a[i] << s) | (a[i-1] >> (64 - s)) : a[i];
+    an[0] = a[0] << s;
+
+    for (int i=0; i<Fr_N64; i++) quo[i] = 0;
+    for (int j=Fr_N64-n; j>=0; j--) {
+        u128 num = ((u128)an[j+n] << 64) | an[j+n-1];
+        u128 qhat = num / bn[n-1];
+        u128 rhat = num % bn[n-1];
+        while ((qhat >> 64) || qhat * bn[n-2] > ((rhat << 64) | an[j+n-2])) {
+            qhat--;
+            rhat += bn[n-1];
+            if (rhat >> 64) break;
+        }
+
+        // an[j..j+n] -= qhat * bn
+        uint64_t borrow = 0;
+        uint64_t carry = 0;
+        for (int i=0; i<n; i++) {
+            u128 p = qhat * bn[i] + carry;
+            carry = (uint64_t)(p >> 64);
+            u128 t = (u128)an[i+j] - (uint64_t)p - borrow;
+            an[i+j] = (uint64_t)t;
+            borrow = (uint64_t)(t >> 64) & 1;
+        }
+        u128 t = (u128)an[j+n] - carry - borrow;
+        an[j+n] = (uint64_t)t;
+
+        if ((uint64_t)(t >> 64)) {
+            // qhat was one too large: add the divisor back.
+            qhat--;
+            uint64_t c = 0;
+            for (int i=0; i<n; i++) {
+                u128 sum = (u128)an[i+j] + bn[i] + c;
+                an[i+j] = (uint64_t)sum;
+                c = (uint64_t)(sum >> 64);
+            }
+            an[j+n] += c;
+        }
+        quo[j] = (uint64_t)qhat;
+    }
+
+    for (int i=0; i<Fr_N64; i++) {
+        rem[i] = i < n ? (s ? (an[i] >> s) | (an[i+1] << (64 - s)) : an[i]) : 0;
     }
-    char *res = mpz_get_str (0, 10, r);
-    mpz_clear(r);
-    return res;
 }
 
 void Fr_idiv(PFrElement r, PFrElement a, PFrElement b) {
-    mpz_t ma;
-    mpz_t mb;
-    mpz_t mr;
-    mpz_init(ma);
-    mpz_init(mb);
-    mpz_init(mr);
-
-    Fr_toMpz(ma, a);
-    // char *s1 = mpz_get_str (0, 10, ma);
-    // printf("s1 %s\n", s1);
-    Fr_toMpz(mb, b);
-    // char *s2 = mpz_get_str (0, 10, mb);
-    // printf("s2 %s\n", s2);
-    mpz_fdiv_q(mr, ma, mb);
-    // char *sr = mpz_get_str (0, 10, mr);
-    // printf("r %s\n", sr);
-    Fr_fromMpz(r, mr);
-
-    mpz_clear(ma);
-    mpz_clear(mb);
-    mpz_clear(mr);
+    if (!(a->type & Fr_LONG) && !(b->type & Fr_LONG) && a->shortVal >= 0 && b->shortVal > 0) {
+        r->type = Fr_SHORT;
+        r->shortVal = a->shortVal / b->shortVal;
+        return;
+    }
+    FrRawElement ma, mb, quo, rem;
+    toCanonical(ma, a);
+    toCanonical(mb, b);
+    if (Fr_rawIsZero(mb)) {
+        // Fr_fail() returns when assertions are compiled out: r is then 0.
+        Fr_fail();
+        r->type = Fr_SHORT;
+        r->shortVal = 0;
+        return;
+    }
+    rawDivMod(quo, rem, ma, mb);
+    setCanonical(r, quo);
 }
 
 void Fr_mod(PFrElement r, PFrElement a, PFrElement b) {
-    mpz_t ma;
-    mpz_t mb;
-    mpz_t mr;
-    mpz_init(ma);
-    mpz_init(mb);
-    mpz_init(mr);
-
-    Fr_toMpz(ma, a);
-    Fr_toMpz(mb, b);
-    mpz_fdiv_r(mr, ma, mb);
-    Fr_fromMpz(r, mr);
-
-    mpz_clear(ma);
-    mpz_clear(mb);
-    mpz_clear(mr);
+    if (!(a->type & Fr_LONG) && !(b->type & Fr_LONG) && a->shortVal >= 0 && b->shortVal > 0) {
+        r->type = Fr_SHORT;
+        r->shortVal = a->shortVal % b->shortVal;
+        return;
+    }
+    FrRawElement ma, mb, quo, rem;
+    toCanonical(ma, a);
+    toCanonical(mb, b);
+    if (Fr_rawIsZero(mb)) {
+        // Fr_fail() returns when assertions are compiled out: r is then 0.
+        Fr_fail();
+        r->type = Fr_SHORT;
+        r->shortVal = 0;
+        return;
+    }
+    rawDivMod(quo, rem, ma, mb);
+    setCanonical(r, rem);
 }
 
+// a^b with b read as an integer in [0, q); 0^0 = 1.
 void Fr_pow(PFrElement r, PFrElement a, PFrElement b) {
-    mpz_t ma;
-    mpz_t mb;
-    mpz_t mr;
-    mpz_init(ma);
-    mpz_init(mb);
-    mpz_init(mr);
-
-    Fr_toMpz(ma, a);
-    Fr_toMpz(mb, b);
-    mpz_powm(mr, ma, mb, q);
-    Fr_fromMpz(r, mr);
-
-    mpz_clear(ma);
-    mpz_clear(mb);
-    mpz_clear(mr);
+    FrRawElement base, e, acc;
+    FrRawElement one = {1, 0, 0, 0};
+    toCanonical(base, a);
+    toCanonical(e, b);
+    Fr_rawToMontgomery(base, base);
+    Fr_rawToMontgomery(acc, one);
+    // Most exponents are small; start at their top set bit.
+    int top = Fr_N64*64-1;
+    while (top >= 0 && !((e[top>>6] >> (top & 63)) & 1)) top--;
+    for (int i=top; i>=0; i--) {
+        Fr_rawMSquare(acc, acc);
+        if ((e[i>>6] >> (i & 63)) & 1) Fr_rawMMul(acc, acc, base);
+    }
+    Fr_rawFromMontgomery(acc, acc);
+    setCanonical(r, acc);
 }
 
-void Fr_inv(PFrElement r, PFrElement a) {
-    mpz_t ma;
-    mpz_t mr;
-    mpz_init(ma);
-    mpz_init(mr);
-
-    Fr_toMpz(ma, a);
-    mpz_invert(mr, ma, q);
-    Fr_fromMpz(r, mr);
-    mpz_clear(ma);
-    mpz_clear(mr);
-}
+// Modular inversion by Bernstein-Yang safegcd, following the variable-time
+// variant of libsecp256k1's modinv64: values are held as five signed 62-bit
+// limbs and batches of 62 divsteps run until g reaches zero. Runs of zero
+// bits are skipped at once. Witness values are not secret, so the run time
+// is free to depend on them.
 
-void Fr_div(PFrElement r, PFrElement a, PFrElement b) {
-    FrElement tmp;
-    Fr_inv(&tmp, b);
-    Fr_mul(r, a, &tmp);
-}
+typedef __int128 FrInt128;
 
-void Fr_fail() {
-    assert(false);
-}
+struct FrSigned62 {
+    int64_t v[5];
+};
 
+struct FrTrans2x2 {
+    int64_t u, v, q, r;
+};
 
-RawFr::RawFr() {
-    Fr_init();
-    set(fZero, 0);
-    set(fOne, 1);
-    neg(fNegOne, fOne);
-}
+struct FrInvModInfo {
+    FrSigned62 modulus;
+    uint64_t modulusInv62; // modulus^-1 mod 2^62
+};
 
-RawFr::~RawFr() {
-}
+static const uint64_t M62 = UINT64_MAX >> 2;
 
-void RawFr::fromString(Element &r, const std::string &s, uint32_t radix) {
-    mpz_t mr;
-    mpz_init_set_str(mr, s.c_str(), radix);
-    mpz_fdiv_r(mr, mr, q);
-    for (int i=0; i<Fr_N64; i++) r.v[i] = 0;
-    mpz_export((void *)(r.v), NULL, -1, 8, -1, 0, mr);
-    Fr_rawToMontgomery(r.v,r.v);
-    mpz_clear(mr);
+static void toSigned62(FrSigned62 &r, const uint64_t *a) {
+    r.v[0] = a[0] & M62;
+    r.v[1] = (a[0] >> 62 | a[1] << 2) & M62;
+    r.v[2] = (a[1] >> 60 | a[2] << 4) & M62;
+    r.v[3] = (a[2] >> 58 | a[3] << 6) & M62;
+    r.v[4] = a[3] >> 56;
 }
 
-void RawFr::fromUI(Element &r, unsigned long int v) {
-    mpz_t mr;
-    mpz_init(mr);
-    mpz_set_ui(mr, v);
-    for (int i=0; i<Fr_N64; i++) r.v[i] = 0;
-    mpz_export((void *)(r.v), NULL, -1, 8, -1, 0, mr);
-    Fr_rawToMontgomery(r.v,r.v);
-    mpz_clear(mr);
+static void fromSigned62(uint64_t *r, const FrSigned62 &a) {
+    r[0] = a.v[0] | (uint64_t)a.v[1] << 62;
+    r[1] = (uint64_t)a.v[1] >> 2 | (uint64_t)a.v[2] << 60;
+    r[2] = (uint64_t)a.v[2] >> 4 | (uint64_t)a.v[3] << 58;
+    r[3] = (uint64_t)a.v[3] >> 6 | (uint64_t)a.v[4] << 56;
 }
 
-RawFr::Element RawFr::set(int value) {
-  Element r;
-  set(r, value);
-  return r;
+static FrInvModInfo makeInvModInfo() {
+    FrInvModInfo info;
+    toSigned62(info.modulus, Fr_rawq);
+    // Newton iteration; each step doubles the number of correct low bits.
+    uint64_t inv = Fr_rawq[0];
+    for (int i = 0; i < 5; i++) inv *= 2 - Fr_rawq[0]*inv;
+    info.modulusInv62 = inv & M62;
+    return info;
 }
 
-void RawFr::set(Element &r, int value) {
-  mpz_t mr;
-  mpz_init(mr);
-  mpz_set_si(mr, value);
-  if (value < 0) {
-      mpz_add(mr, mr, q);
-  }
-
-  mpz_export((void *)(r.v), NULL, -1, 8, -1, 0, mr);
-      
-  for (int i=0; i<Fr_N64; i++) r.v[i] = 0;
-  mpz_export((void *)(r.v), NULL, -1, 8, -1, 0, mr);
-  Fr_rawToMontgomery(r.v,r.v);
-  mpz_clear(mr);
+// 62 divsteps on the low bits of f and g. Returns the new eta and the
+// transition matrix scaled by 2^62.
+static int64_t invDivsteps62(int64_t eta, uint64_t f0, uint64_t g0, FrTrans2x2 &t) {
+    uint64_t u = 1, v = 0, q = 0, r = 1;
+    uint64_t f = f0, g = g0, m, w;
+    int i = 62, limit, zeros;
+
+    for (;;) {
+        // Shifts out the zero bits of g, up to the steps left.
+        zeros = __builtin_ctzll(g | (UINT64_MAX << i));
+        g >>= zeros;
+        u <<= zeros;
+        v <<= zeros;
+        eta -= zeros;
+        i -= zeros;
+        if (i == 0) break;
+
+        // g is odd: with eta < 0 swap f and g first. Then cancel as many low
+        // bits of g as allowed at once by adding a multiple w of f.
+        if (eta < 0) {
+            uint64_t tmp;
+            eta = -eta;
+            tmp = f; f = g; g = -tmp;
+            tmp = u; u = q; q = -tmp;
+            tmp = v; v = r; r = -tmp;
+            limit = ((int)eta + 1) > i ? i : ((int)eta + 1);
+            m = (UINT64_MAX >> (64 - limit)) & 63U;
+            w = (f * g * (f * f - 2)) & m;
+        } else {
+            limit = ((int)eta + 1) > i ? i : ((int)eta + 1);
+            m = (UINT64_MAX >> (64 - limit)) & 15U;
+            w = f + (((f + 1) & 4) << 1);
+            w = (-w * g) & m;
+        }
+        g += f * w;
+        q += u * w;
+        r += v * w;
+    }
+    t.u = (int64_t)u;
+    t.v = (int64_t)v;
+    t.q = (int64_t)q;
+    t.r = (int64_t)r;
+    return eta;
 }
 
-std::string RawFr::toString(const Element &a, uint32_t radix) {
-    Element tmp;
-    mpz_t r;
-    Fr_rawFromMontgomery(tmp.v, a.v);
-    mpz_init(r);
-    mpz_import(r, Fr_N64, -1, 8, -1, 0, (const void *)(tmp.v));
-    char *res = mpz_get_str (0, radix, r);
-    mpz_clear(r);
-    std::string resS(res);
-    free(res);
-    return resS;
+// [d,e] = t*[d,e]/2^62 mod modulus, adding the multiple of the modulus that
+// makes the division exact.
+static void invUpdateDE(FrSigned62 &d, FrSigned62 &e, const FrTrans2x2 &t, const FrInvModInfo &info) {
+    const int64_t *m = info.modulus.v;
+    const int64_t sd = d.v[4] >> 63, se = e.v[4] >> 63;
+    int64_t md = (t.u & sd) + (t.v & se);
+    int64_t me = (t.q & sd) + (t.r & se);
+    FrInt128 cd = (FrInt128)t.u*d.v[0] + (FrInt128)t.v*e.v[0];
+    FrInt128 ce = (FrInt128)t.q*d.v[0] + (FrInt128)t.r*e.v[0];
+    md -= (info.modulusInv62*(uint64_t)cd + md) & M62;
+    me -= (info.modulusInv62*(uint64_t)ce + me) & M62;
+    cd += (FrInt128)m[0]*md;
+    ce += (FrInt128)m[0]*me;
+    cd >>= 62;
+    ce >>= 62;
+    for (int i = 1; i < 5; i++) {
+        cd += (FrInt128)t.u*d.v[i] + (FrInt128)t.v*e.v[i] + (FrInt128)m[i]*md;
+        ce += (FrInt128)t.q*d.v[i] + (FrInt128)t.r*e.v[i] + (FrInt128)m[i]*me;
+        d.v[i-1] = (int64_t)cd & M62;
+        e.v[i-1] = (int64_t)ce & M62;
+        cd >>= 62;
+        ce >>= 62;
+    }
+    d.v[4] = (int64_t)cd;
+    e.v[4] = (int64_t)ce;
 }
 
-void RawFr::inv(Element &r, const Element &a) {
-    mpz_t mr;
-    mpz_init(mr);
-    mpz_import(mr, Fr_N64, -1, 8, -1, 0, (const void *)(a.v));
-    mpz_invert(mr, mr, q);
-
-
-    for (int i=0; i<Fr_N64; i++) r.v[i] = 0;
-    mpz_export((void *)(r.v), NULL, -1, 8, -1, 0, mr);
-
-    Fr_rawMMul(r.v, r.v,Fr_rawR3);
-    mpz_clear(mr);
+// [f,g] = t*[f,g]/2^62, which is exact, on their len low limbs.
+static void invUpdateFG(int len, FrSigned62 &f, FrSigned62 &g, const FrTrans2x2 &t) {
+    FrInt128 cf = (FrInt128)t.u*f.v[0] + (FrInt128)t.v*g.v[0];
+    FrInt128 cg = (FrInt128)t.q*f.v[0] + (FrInt128)t.r*g.v[0];
+    cf >>= 62;
+    cg >>= 62;
+    for (int i = 1; i < len; i++) {
+        cf += (FrInt128)t.u*f.v[i] + (FrInt128)t.v*g.v[i];
+        cg += (FrInt128)t.q*f.v[i] + (FrInt128)t.r*g.v[i];
+        f.v[i-1] = (int64_t)cf & M62;
+        g.v[i-1] = (int64_t)cg & M62;
+        cf >>= 62;
+        cg >>= 62;
+    }
+    f.v[len-1] = (int64_t)cf;
+    g.v[len-1] = (int64_t)cg;
 }
 
-void RawFr::div(Element &r, const Element &a, const Element &b) {
-    Element tmp;
-    inv(tmp, b);
-    mul(r, a, tmp);
+// Brings r from (-2*modulus, modulus) to [0, modulus), negating it first
+// when sign is negative.
+static void invNormalize(FrSigned62 &r, int64_t sign, const FrInvModInfo &info) {
+    const int64_t *m = info.modulus.v;
+    int64_t condAdd, condNegate;
+
+    condAdd = r.v[4] >> 63;
+    for (int i = 0; i < 5; i++) r.v[i] += m[i] & condAdd;
+    condNegate = sign >> 63;
+    for (int i = 0; i < 5; i++) r.v[i] = (r.v[i] ^ condNegate) - condNegate;
+    for (int i = 0; i < 4; i++) {
+        r.v[i+1] += r.v[i] >> 62;
+        r.v[i] &= M62;
+    }
+
+    condAdd = r.v[4] >> 63;
+    for (int i = 0; i < 5; i++) r.v[i] += m[i] & condAdd;
+    for (int i = 0; i < 4; i++) {
+        r.v[i+1] += r.v[i] >> 62;
+        r.v[i] &= M62;
+    }
 }
 
-#define BIT_IS_SET(s, p) (s[p>>3] & (1 << (p & 0x7)))
-void RawFr::exp(Element &r, const Element &base, uint8_t* scalar, unsigned int scalarSize) {
-    bool oneFound = false;
-    Element copyBase;
-    copy(copyBase, base);
-    for (int i=scalarSize*8-1; i>=0; i--) {
-        if (!oneFound) {
-            if ( !BIT_IS_SET(scalar, i) ) continue;
-            copy(r, copyBase);
-            oneFound = true;
-            continue;
-        }
-        square(r, r);
-        if ( BIT_IS_SET(scalar, i) ) {
-            mul(r, r, copyBase);
+// r = a^-1 mod q for a in [0, q), with 0 mapped to 0 like mpz_invert left it.
+static void rawInverse(FrRawElement r, const FrRawElement a) {
+    static const FrInvModInfo info = makeInvModInfo();
+    FrSigned62 d = {{0, 0, 0, 0, 0}};
+    FrSigned62 e = {{1, 0, 0, 0, 0}};
+    FrSigned62 f = info.modulus;
+    FrSigned62 g;
+    toSigned62(g, a);
+    int64_t eta = -1;
+    int len = 5;
+
+    for (;;) {
+        FrTrans2x2 t;
+        eta = invDivsteps62(eta, f.v[0], g.v[0], t);
+        invUpdateDE(d, e, t, info);
+        invUpdateFG(len, f, g, t);
+
+        int64_t zero = 0;
+        for (int i = 0; i < len; i++) zero |= g.v[i];
+        if (zero == 0) break;
+
+        // f and g shrink as they converge: drop their top limb once it only
+        // holds the sign of both, folding it into the limb below.
+        int64_t fn = f.v[len-1], gn = g.v[len-1];
+        if (len > 1 && (fn ^ (fn >> 63)) == 0 && (gn ^ (gn >> 63)) == 0) {
+            f.v[len-2] |= (int64_t)((uint64_t)fn << 62);
+            g.v[len-2] |= (int64_t)((uint64_t)gn << 62);
+            len--;
         }
     }
-    if (!oneFound) {
-        copy(r, fOne);
-    }
-}
 
-void RawFr::toMpz(mpz_t r, const Element &a) {
-    Element tmp;
-    Fr_rawFromMontgomery(tmp.v, a.v);
-    mpz_import(r, Fr_N64, -1, 8, -1, 0, (const void *)tmp.v);
+    invNormalize(d, f.v[len-1], info);
+    fromSigned62(r, d);
 }
 
-void RawFr::fromMpz(Element &r, const mpz_t a) {
-    for (int i=0; i<Fr_N64; i++) r.v[i] = 0;
-    mpz_export((void *)(r.v), NULL, -1, 8, -1, 0, a);
-    Fr_rawToMontgomery(r.v, r.v);
+void Fr_rawInv(FrRawElement pRawResult, const FrRawElement pRawA) {
+    // a*R -> (a*R)^-1 -> a^-1*R^-1*R^3/R = a^-1*R
+    FrRawElement tmp;
+    rawInverse(tmp, pRawA);
+    Fr_rawMMul(pRawResult, tmp, Fr_rawR3);
 }
 
-int RawFr::toRprBE(const Element &element, uint8_t *data, int bytes)
-{
-    if (bytes < Fr_N64 * 8) {
-      return -(Fr_N64 * 8);
-    }
+void Fr_inv(PFrElement r, PFrElement a) {
+    FrElement n;
+    FrRawElement v, inv;
+    Fr_toLongNormal(&n, a);
+    for (int i=0; i<Fr_N64; i++) v[i] = n.longVal[i];
+    rawInverse(inv, v);
+    r->type = Fr_LONGMONTGOMERY;
+    r->shortVal = 0;
+    Fr_rawToMontgomery(v, inv);
+    for (int i=0; i<Fr_N64; i++) r->longVal[i] = v[i];
+}
 
-    mpz_t r;
-    mpz_init(r);
-  
-    toMpz(r, element);
-    
-    mpz_export(data, NULL, 1, 8, 1, 0, r);
-  
-    return Fr_N64 * 8;
+void Fr_div(PFrElement r, PFrElement a, PFrElement b) {
+    FrElement tmp;
+    Fr_inv(&tmp, b);
+    Fr_mul(r, a, &tmp);
 }
 
-int RawFr::fromRprBE(Element &element, const uint8_t *data, int bytes)
-{
-    if (bytes < Fr_N64 * 8) {
-      return -(Fr_N64* 8);
+void Fr_batchInv(PFrElement r, PFrElement a, uint n) {
+    static thread_local std::vector<RawFr::Element> tmp;
+    tmp.resize(n);
+    for (uint i=0; i<n; i++) {
+        if (a[i].type == Fr_LONGMONTGOMERY) {
+            for (int k=0; k<Fr_N64; k++) tmp[i].v[k] = a[i].longVal[k];
+        } else {
+            FrElement nrm;
+            Fr_toLongNormal(&nrm, &a[i]);
+            for (int k=0; k<Fr_N64; k++) tmp[i].v[k] = nrm.longVal[k];
+            Fr_rawToMontgomery(tmp[i].v, tmp[i].v);
+        }
     }
-    mpz_t r;
-    mpz_init(r);
+    RawFr::field.batchInv(tmp.data(), tmp.data(), n);
+    for (uint i=0; i<n; i++) {
+        r[i].type = Fr_LONGMONTGOMERY;
+        r[i].shortVal = 0;
+        for (int k=0; k<Fr_N64; k++) r[i].longVal[k] = tmp[i].v[k];
+    }
+}
 
-    mpz_import(r, Fr_N64 * 8, 0, 1, 0, 0, data);
-    fromMpz(element, r);
-    return Fr_N64 * 8;
+void Fr_fail() {
+    assert(false);
 }
 
-static bool init = Fr_init();
 
-RawFr RawFr::field;
+constexpr uint64_t FrParams::q[Fr_N64];
+constexpr uint64_t FrParams::R2[Fr_N64];
+
+template <>
+void RawFr::inv(Element &r, const Element &a) {
+    Fr_rawInv(r.v, a.v);
+}
 
@@ -3,7 +3,7 @@
 
 #include <stdint.h>
 #include <string>
-#include <gmp.h>
+#include "field.hpp"
 
 #ifdef __APPLE__
 #include <sys/types.h> // typedef unsigned int uint;
@@ -76,86 +76,41 @@ void Fr_str2element(PFrElement pE, char const*s, uint base);
 char *Fr_element2str(PFrElement pE);
 void Fr_idiv(PFrElement r, PFrElement a, PFrElement b);
 void Fr_mod(PFrElement r, PFrElement a, PFrElement b);
+void Fr_rawInv(FrRawElement pRawResult, const FrRawElement pRawA);
 void Fr_inv(PFrElement r, PFrElement a);
 void Fr_div(PFrElement r, PFrElement a, PFrElement b);
+// r[i] = 1/a[i] for n elements with a single inversion; zeros map to zero.
+void Fr_batchInv(PFrElement r, PFrElement a, uint n);
 void Fr_pow(PFrElement r, PFrElement a, PFrElement b);
 
-class RawFr {
-
-public:
-    const static int N64 = Fr_N64;
-    const static int MaxBits = 254;
-
-
-    struct Element {
-        FrRawElement v;
-    };
-
-private:
-    Element fZero;
-    Element fOne;
-    Element fNegOne;
-
-public:
-
-    RawFr();
-    ~RawFr();
-
-    const Element &zero() { return fZero; };
-    const Element &one() { return fOne; };
-    const Element &negOne() { return fNegOne; };
-    Element set(int value);
-    void set(Element &r, int value);
-
-    void fromString(Element &r, const std::string &n, uint32_t radix = 10);
-    std::string toString(const Element &a, uint32_t radix = 10);
-
-    void inline copy(Element &r, const Element &a) { Fr_rawCopy(r.v, a.v); };
-    void inline swap(Element &a, Element &b) { Fr_rawSwap(a.v, b.v); };
-    void inline add(Element &r, const Element &a, const Element &b) { Fr_rawAdd(r.v, a.v, b.v); };
-    void inline sub(Element &r, const Element &a, const Element &b) { Fr_rawSub(r.v, a.v, b.v); };
-    void inline mul(Element &r, const Element &a, const Element &b) { Fr_rawMMul(r.v, a.v, b.v); };
-
-    Element inline add(const Element &a, const Element &b) { Element r; Fr_rawAdd(r.v, a.v, b.v); return r;};
-    Element inline sub(const Element &a, const Element &b) { Element r; Fr_rawSub(r.v, a.v, b.v); return r;};
-    Element inline mul(const Element &a, const Element &b) { Element r; Fr_rawMMul(r.v, a.v, b.v); return r;};
-
-    Element inline neg(const Element &a) { Element r; Fr_rawNeg(r.v, a.v); return r; };
-    Element inline square(const Element &a) { Element r; Fr_rawMSquare(r.v, a.v); return r; };
-
-    Element inline add(int a, const Element &b) { return add(set(a), b);};
-    Element inline sub(int a, const Element &b) { return sub(set(a), b);};
-    Element inline mul(int a, const Element &b) { return mul(set(a), b);};
-
-    Element inline add(const Element &a, int b) { return add(a, set(b));};
-    Element inline sub(const Element &a, int b) { return sub(a, set(b));};
-    Element inline mul(const Element &a, int b) { return mul(a, set(b));};
-
-    void inline mul1(Element &r, const Element &a, uint64_t b) { Fr_rawMMul1(r.v, a.v, b); };
-    void inline neg(Element &r, const Element &a) { Fr_rawNeg(r.v, a.v); };
-    void inline square(Element &r, const Element &a) { Fr_rawMSquare(r.v, a.v); };
-    void inv(Element &r, const Element &a);
-    void div(Element &r, const Element &a, const Element &b);
-    void exp(Element &r, const Element &base, uint8_t* scalar, unsigned int scalarSize);
-
-    void inline toMontgomery(Element &r, const Element &a) { Fr_rawToMontgomery(r.v, a.v); };
-    void inline fromMontgomery(Element &r, const Element &a) { Fr_rawFromMontgomery(r.v, a.v); };
-    int inline eq(const Element &a, const Element &b) { return Fr_rawIsEq(a.v, b.v); };
-    int inline isZero(const Element &a) { return Fr_rawIsZero(a.v); };
-
-    void toMpz(mpz_t r, const Element &a);
-    void fromMpz(Element &a, const mpz_t r);
-
-    int toRprBE(const Element &element, uint8_t *data, int bytes);
-    int fromRprBE(Element &element, const uint8_t *data, int bytes);
-
-    int bytes ( void ) { return Fr_N64 * 8; };
+// BN254 scalar field, the one circom uses by default.
+struct FrParams {
+    static const int N64 = Fr_N64;
+    static const int MaxBits = 254;
+    static constexpr uint64_t q[Fr_N64] = {0x43e1f593f0000001,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029};
+    static constexpr uint64_t R2[Fr_N64] = {0x1bb8e645ae216da7,0x53fe3ab1e35c59e3,0x8c49833d53bb8085,0x0216d0b17f4e44a5};
+};
 
-    void fromUI(Element &r, unsigned long int v);
+// BN254 runs on the Fr_raw* backend (fr.asm or fr_generic.cpp) rather than
+// the template kernels.
+template <>
+struct FieldKernels<FrParams, Fr_N64> {
+    static inline void add(FrRawElement r, const FrRawElement a, const FrRawElement b) { Fr_rawAdd(r, a, b); }
+    static inline void sub(FrRawElement r, const FrRawElement a, const FrRawElement b) { Fr_rawSub(r, a, b); }
+    static inline void neg(FrRawElement r, const FrRawElement a) { Fr_rawNeg(r, a); }
+    static inline void mul(FrRawElement r, const FrRawElement a, const FrRawElement b) { Fr_rawMMul(r, a, b); }
+    static inline void square(FrRawElement r, const FrRawElement a) { Fr_rawMSquare(r, a); }
+    static inline void toMontgomery(FrRawElement r, const FrRawElement &a) { Fr_rawToMontgomery(r, a); }
+    static inline void fromMontgomery(FrRawElement r, const FrRawElement &a) { Fr_rawFromMontgomery(r, a); }
+    static inline int eq(const FrRawElement a, const FrRawElement b) { return Fr_rawIsEq(a, b); }
+    static inline int isZero(const FrRawElement a) { return Fr_rawIsZero(a); }
+};
 
-    static RawFr field;
+// Uses Fr_rawInv(), the variable-time safegcd in fr.cpp.
+template <>
+void Field<FrParams>::inv(Element &r, const Element &a);
 
-};
+typedef Field<FrParams> RawFr;
 
 
 #endif // __FR_H
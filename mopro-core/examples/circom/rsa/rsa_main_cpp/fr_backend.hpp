@@ -0,0 +1,76 @@
+#ifndef __FR_BACKEND_H
+#define __FR_BACKEND_H
+
+#include "fr.hpp"
+
+// The Fr_* primitives are implemented by interchangeable backends: fr.asm
+// (x86-64 with BMI2 and ADX) and the portable C++ one in fr_generic.cpp.
+// fr_dispatch.cpp defines the public symbols and forwards them to the best
+// backend the CPU supports, picked once when the program loads.
+
+// X(return type, name, parameters, arguments) for every dispatched function.
+#define FR_BACKEND_FUNCTIONS(X) \
+    X(void, copy, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, copyn, (PFrElement r, PFrElement a, int n), (r, a, n)) \
+    X(void, add, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, sub, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, neg, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, mul, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, square, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, band, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, bor, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, bxor, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, bnot, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, shl, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, shr, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, eq, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, neq, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, lt, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, gt, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, leq, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, geq, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, land, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, lor, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, lnot, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, toNormal, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, toLongNormal, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, toMontgomery, (PFrElement r, PFrElement a), (r, a)) \
+    X(int, isTrue, (PFrElement pE), (pE)) \
+    X(int, toInt, (PFrElement pE), (pE)) \
+    X(void, rawCopy, (FrRawElement pRawResult, const FrRawElement pRawA), (pRawResult, pRawA)) \
+    X(void, rawSwap, (FrRawElement pRawResult, FrRawElement pRawA), (pRawResult, pRawA)) \
+    X(void, rawAdd, (FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB), (pRawResult, pRawA, pRawB)) \
+    X(void, rawSub, (FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB), (pRawResult, pRawA, pRawB)) \
+    X(void, rawNeg, (FrRawElement pRawResult, const FrRawElement pRawA), (pRawResult, pRawA)) \
+    X(void, rawMMul, (FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB), (pRawResult, pRawA, pRawB)) \
+    X(void, rawMSquare, (FrRawElement pRawResult, const FrRawElement pRawA), (pRawResult, pRawA)) \
+    X(void, rawMMul1, (FrRawElement pRawResult, const FrRawElement pRawA, uint64_t pRawB), (pRawResult, pRawA, pRawB)) \
+    X(void, rawToMontgomery, (FrRawElement pRawResult, const FrRawElement &pRawA), (pRawResult, pRawA)) \
+    X(void, rawFromMontgomery, (FrRawElement pRawResult, const FrRawElement &pRawA), (pRawResult, pRawA)) \
+    X(int, rawIsEq, (const FrRawElement pRawA, const FrRawElement pRawB), (pRawA, pRawB)) \
+    X(int, rawIsZero, (const FrRawElement pRawB), (pRawB))
+
+struct FrBackend {
+    const char *name;
+    bool (*supported)();
+#define FR_BACKEND_MEMBER(ret, name, params, args) ret (*name) params;
+    FR_BACKEND_FUNCTIONS(FR_BACKEND_MEMBER)
+#undef FR_BACKEND_MEMBER
+};
+
+extern const FrBackend Fr_genericBackend;
+#ifdef FR_USE_ASM
+extern const FrBackend Fr_asmBackend;
+#endif
+
+// Backends built into this binary, fastest first, ending with NULL.
+extern const FrBackend *const Fr_backends[];
+
+// Backend the Fr_* functions currently forward to.
+const FrBackend *Fr_currentBackend();
+
+// Switches to the backend called name if it is built in and the CPU runs
+// it. The FR_BACKEND environment variable does the same at load time.
+bool Fr_useBackend(const char *name);
+
+#endif // __FR_BACKEND_H
@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+#include "fr.hpp"
+#include "fr_backend.hpp"
+#include "fr_vec.hpp"
+
+// Times the field primitives of every backend this CPU runs, calling them
+// through the backend tables so that each one is measured on its own.
+// Run with `make fr_bench && ./fr_bench`.
+
+#define BENCH_N 4096
+#define BENCH_ROUNDS 256
+
+static FrRawElement ra[BENCH_N], rb[BENCH_N], rr[BENCH_N];
+static FrElement ea[BENCH_N], eb[BENCH_N], er[BENCH_N];
+
+static void fillInputs() {
+    uint64_t s = 0x9e3779b97f4a7c15;
+    for (int i=0; i<BENCH_N; i++) {
+        for (int j=0; j<Fr_N64; j++) {
+            s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+            ra[i][j] = s;
+            s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+            rb[i][j] = s;
+        }
+        ra[i][3] &= 0x0fffffffffffffff;
+        rb[i][3] &= 0x0fffffffffffffff;
+        ea[i].shortVal = 0;
+        ea[i].type = Fr_LONGMONTGOMERY;
+        memcpy(ea[i].longVal, ra[i], sizeof(FrRawElement));
+        // Mix short and long operands the way the generated code does.
+        eb[i].shortVal = i;
+        eb[i].type = (i & 1) ? Fr_LONGMONTGOMERY : Fr_SHORT;
+        memcpy(eb[i].longVal, rb[i], sizeof(FrRawElement));
+    }
+}
+
+static double nsPerOp(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+    return d.count() / ((double)BENCH_N * BENCH_ROUNDS);
+}
+
+#define BENCH(label, body) do { \
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(); \
+    for (int k=0; k<BENCH_ROUNDS; k++) \
+        for (int i=0; i<BENCH_N; i++) { body; } \
+    printf("  %-20s %8.2f ns\n", label, nsPerOp(start)); \
+} while (0)
+
+static void benchBackend(const FrBackend *b) {
+    printf("%s\n", b->name);
+    BENCH("rawMMul", b->rawMMul(rr[i], ra[i], rb[i]));
+    BENCH("rawMSquare", b->rawMSquare(rr[i], ra[i]));
+    BENCH("rawAdd", b->rawAdd(rr[i], ra[i], rb[i]));
+    BENCH("rawSub", b->rawSub(rr[i], ra[i], rb[i]));
+    BENCH("rawFromMontgomery", b->rawFromMontgomery(rr[i], ra[i]));
+    BENCH("mul", b->mul(&er[i], &ea[i], &eb[i]));
+    BENCH("add", b->add(&er[i], &ea[i], &eb[i]));
+    BENCH("lt", b->lt(&er[i], &ea[i], &eb[i]));
+    BENCH("toNormal", b->toNormal(&er[i], &ea[i]));
+}
+
+int main() {
+    fillInputs();
+
+    printf("default backend: %s\n", Fr_currentBackend()->name);
+    for (int i=0; Fr_backends[i]; i++) {
+        if (Fr_backends[i]->supported()) {
+            benchBackend(Fr_backends[i]);
+        } else {
+            printf("%s: not supported by this CPU\n", Fr_backends[i]->name);
+        }
+    }
+
+    printf("array kernels\n");
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int k=0; k<BENCH_ROUNDS; k++) Fr_rawMMulN(rr, ra, rb, BENCH_N);
+    printf("  %-20s %8.2f ns\n", "rawMMulN", nsPerOp(start));
+    start = std::chrono::steady_clock::now();
+    for (int k=0; k<BENCH_ROUNDS; k++) Fr_rawAddN(rr, ra, rb, BENCH_N);
+    printf("  %-20s %8.2f ns\n", "rawAddN", nsPerOp(start));
+    start = std::chrono::steady_clock::now();
+    for (int k=0; k<BENCH_ROUNDS; k++) Fr_rawFromMontgomeryN(rr, ra, BENCH_N);
+    printf("  %-20s %8.2f ns\n", "rawFromMontgomeryN", nsPerOp(start));
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "fr_backend.hpp"
+#include <atomic>
+#include <stdlib.h>
+#include <string.h>
+#ifdef FR_USE_ASM
+#include <cpuid.h>
+#endif
+
+
+#ifdef FR_USE_ASM
+
+// fr.asm is assembled with --prefix asm_, so its entry points do not clash
+// with the dispatching Fr_* functions below.
+extern "C" {
+
+#define FR_ASM_DECLARE(ret, name, params, args) ret asm_Fr_##name params;
+FR_BACKEND_FUNCTIONS(FR_ASM_DECLARE)
+#undef FR_ASM_DECLARE
+
+// The prefix applies to fr.asm's external references too.
+void asm_Fr_fail() {
+    Fr_fail();
+}
+
+// fr.asm does not export its single-word multiplication.
+void asm_Fr_rawMMul1(FrRawElement pRawResult, const FrRawElement pRawA, uint64_t pRawB) {
+    FrRawElement b = {pRawB, 0, 0, 0};
+    asm_Fr_rawMMul(pRawResult, pRawA, b);
+}
+
+}
+
+// fr.asm multiplies with mulx and carries with adcx/adox.
+static bool asmSupported() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+    return (ebx & bit_BMI2) && (ebx & bit_ADX);
+}
+
+#define FR_ASM_ENTRY(ret, name, params, args) asm_Fr_##name,
+
+const FrBackend Fr_asmBackend = {
+    "asm",
+    asmSupported,
+    FR_BACKEND_FUNCTIONS(FR_ASM_ENTRY)
+};
+
+#endif // FR_USE_ASM
+
+
+const FrBackend *const Fr_backends[] = {
+#ifdef FR_USE_ASM
+    &Fr_asmBackend,
+#endif
+    &Fr_genericBackend,
+    NULL
+};
+
+static const FrBackend *findBackend(const char *name) {
+    for (int i=0; Fr_backends[i]; i++) {
+        if (strcmp(Fr_backends[i]->name, name) == 0 && Fr_backends[i]->supported()) {
+            return Fr_backends[i];
+        }
+    }
+    return NULL;
+}
+
+static const FrBackend *selectBackend() {
+    const char *forced = getenv("FR_BACKEND");
+    if (forced) {
+        const FrBackend *b = findBackend(forced);
+        if (b) return b;
+    }
+    for (int i=0; Fr_backends[i]; i++) {
+        if (Fr_backends[i]->supported()) return Fr_backends[i];
+    }
+    return &Fr_genericBackend;
+}
+
+// Read on every call and written by Fr_useBackend from any thread. The
+// constant initializer runs before any static constructor.
+static std::atomic<const FrBackend *> current(NULL);
+
+// Static constructors of other files may use the field before this file's
+// run, hence the lazy check. A concurrent Fr_useBackend wins over the lazy
+// pick.
+static inline const FrBackend *backend() {
+    const FrBackend *b = current.load(std::memory_order_acquire);
+    if (b == NULL) {
+        const FrBackend *selected = selectBackend();
+        if (current.compare_exchange_strong(b, selected, std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+            b = selected;
+        }
+    }
+    return b;
+}
+
+// Decide during static initialization, before threads usually start.
+static const FrBackend *const initialBackend = backend();
+
+const FrBackend *Fr_currentBackend() {
+    return backend();
+}
+
+bool Fr_useBackend(const char *name) {
+    const FrBackend *b = findBackend(name);
+    if (b) current.store(b, std::memory_order_release);
+    return b != NULL;
+}
+
+#define FR_DISPATCH(ret, name, params, args) \
+    ret Fr_##name params { return backend()->name args; }
+
+FR_BACKEND_FUNCTIONS(FR_DISPATCH)
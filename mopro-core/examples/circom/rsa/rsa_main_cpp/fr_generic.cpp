@@ -0,0 +1,576 @@
+#include "fr_backend.hpp"
+#include <string.h>
+
+// Portable backend: the same primitives as fr.asm written with unsigned
+// __int128, for hosts without nasm or without BMI2/ADX. Elements use the
+// same representation, so values can move freely between backends.
+
+typedef unsigned __int128 u128;
+
+// Field constants shared by every backend.
+FrElement Fr_q = {0, Fr_LONG, {0x43e1f593f0000001,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029}};
+FrElement Fr_R3 = {0, Fr_LONG, {0x5e94d8e1b4bf0040,0x2a489cbe1cfbb6b8,0x893cc664a19fcfed,0x0cf8594b7fcc657c}};
+FrRawElement Fr_rawq = {0x43e1f593f0000001,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029};
+FrRawElement Fr_rawR3 = {0x5e94d8e1b4bf0040,0x2a489cbe1cfbb6b8,0x893cc664a19fcfed,0x0cf8594b7fcc657c};
+
+namespace fr_generic {
+
+#define FR_GENERIC_DECLARE(ret, name, params, args) ret name params;
+FR_BACKEND_FUNCTIONS(FR_GENERIC_DECLARE)
+#undef FR_GENERIC_DECLARE
+
+static const FrRawElement half = {0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014};
+static const FrRawElement R2 = {0x1bb8e645ae216da7,0x53fe3ab1e35c59e3,0x8c49833d53bb8085,0x0216d0b17f4e44a5};
+static const uint64_t lboMask = 0x3fffffffffffffff;
+static const uint64_t np = 0xc2e1f593efffffff;
+
+static inline int rawCmp(const FrRawElement a, const FrRawElement b) {
+    for (int i=Fr_N64-1; i>=0; i--) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+static inline uint64_t rawSubBorrow(FrRawElement r, const FrRawElement a, const FrRawElement b) {
+    uint64_t borrow = 0;
+    for (int i=0; i<Fr_N64; i++) {
+        u128 d = (u128)a[i] - b[i] - borrow;
+        r[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    return borrow;
+}
+
+static inline uint64_t rawAddCarry(FrRawElement r, const FrRawElement a, const FrRawElement b) {
+    uint64_t carry = 0;
+    for (int i=0; i<Fr_N64; i++) {
+        u128 s = (u128)a[i] + b[i] + carry;
+        r[i] = (uint64_t)s;
+        carry = (uint64_t)(s >> 64);
+    }
+    return carry;
+}
+
+static inline void rawReduceOnce(FrRawElement r) {
+    if (rawCmp(r, Fr_rawq) >= 0) rawSubBorrow(r, r, Fr_rawq);
+}
+
+/*****************************************************************************************
+ * Raw operations
+ *****************************************************************************************/
+
+void rawCopy(FrRawElement pRawResult, const FrRawElement pRawA) {
+    for (int i=0; i<Fr_N64; i++) pRawResult[i] = pRawA[i];
+}
+
+void rawSwap(FrRawElement pRawResult, FrRawElement pRawA) {
+    FrRawElement tmp;
+    rawCopy(tmp, pRawResult);
+    rawCopy(pRawResult, pRawA);
+    rawCopy(pRawA, tmp);
+}
+
+void rawAdd(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB) {
+    uint64_t carry = rawAddCarry(pRawResult, pRawA, pRawB);
+    if (carry || rawCmp(pRawResult, Fr_rawq) >= 0) rawSubBorrow(pRawResult, pRawResult, Fr_rawq);
+}
+
+void rawSub(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB) {
+    if (rawSubBorrow(pRawResult, pRawA, pRawB)) rawAddCarry(pRawResult, pRawResult, Fr_rawq);
+}
+
+void rawNeg(FrRawElement pRawResult, const FrRawElement pRawA) {
+    if (rawIsZero(pRawA)) {
+        for (int i=0; i<Fr_N64; i++) pRawResult[i] = 0;
+    } else {
+        rawSubBorrow(pRawResult, Fr_rawq, pRawA);
+    }
+}
+
+// CIOS Montgomery multiplication, unrolled. The top word of q is below
+// 2^62, so the running value fits in four words and the carry out of each
+// round is just C + A.
+void rawMMul(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB) {
+    uint64_t t0 = 0, t1 = 0, t2 = 0, t3 = 0;
+    for (int i=0; i<Fr_N64; i++) {
+        uint64_t bi = pRawB[i];
+        u128 p = (u128)pRawA[0] * bi + t0;
+        t0 = (uint64_t)p;
+        uint64_t A = (uint64_t)(p >> 64);
+        uint64_t m = t0 * np;
+        u128 c = (u128)m * Fr_rawq[0] + t0;
+        uint64_t C = (uint64_t)(c >> 64);
+
+        p = (u128)pRawA[1] * bi + t1 + A;
+        t1 = (uint64_t)p; A = (uint64_t)(p >> 64);
+        c = (u128)m * Fr_rawq[1] + t1 + C;
+        t0 = (uint64_t)c; C = (uint64_t)(c >> 64);
+
+        p = (u128)pRawA[2] * bi + t2 + A;
+        t2 = (uint64_t)p; A = (uint64_t)(p >> 64);
+        c = (u128)m * Fr_rawq[2] + t2 + C;
+        t1 = (uint64_t)c; C = (uint64_t)(c >> 64);
+
+        p = (u128)pRawA[3] * bi + t3 + A;
+        t3 = (uint64_t)p; A = (uint64_t)(p >> 64);
+        c = (u128)m * Fr_rawq[3] + t3 + C;
+        t2 = (uint64_t)c; C = (uint64_t)(c >> 64);
+
+        t3 = C + A;
+    }
+    FrRawElement t = {t0, t1, t2, t3};
+    FrRawElement d;
+    if (rawSubBorrow(d, t, Fr_rawq)) {
+        rawCopy(pRawResult, t);
+    } else {
+        rawCopy(pRawResult, d);
+    }
+}
+
+void rawMSquare(FrRawElement pRawResult, const FrRawElement pRawA) {
+    rawMMul(pRawResult, pRawA, pRawA);
+}
+
+void rawMMul1(FrRawElement pRawResult, const FrRawElement pRawA, uint64_t pRawB) {
+    FrRawElement b = {pRawB, 0, 0, 0};
+    rawMMul(pRawResult, pRawA, b);
+}
+
+void rawToMontgomery(FrRawElement pRawResult, const FrRawElement &pRawA) {
+    rawMMul(pRawResult, pRawA, R2);
+}
+
+void rawFromMontgomery(FrRawElement pRawResult, const FrRawElement &pRawA) {
+    FrRawElement one = {1, 0, 0, 0};
+    rawMMul(pRawResult, pRawA, one);
+}
+
+int rawIsEq(const FrRawElement pRawA, const FrRawElement pRawB) {
+    return rawCmp(pRawA, pRawB) == 0;
+}
+
+int rawIsZero(const FrRawElement pRawB) {
+    return (pRawB[0] | pRawB[1] | pRawB[2] | pRawB[3]) == 0;
+}
+
+/*****************************************************************************************
+ * Element operations
+ *****************************************************************************************/
+
+static inline bool isLong(PFrElement a) { return a->type & Fr_LONG; }
+static inline bool isMontgomery(PFrElement a) { return (a->type & Fr_LONGMONTGOMERY) == Fr_LONGMONTGOMERY; }
+
+// FrElement is packed, so longVal may sit at any address. The raw routines
+// only see aligned copies, moved in and out with memcpy.
+static inline void loadLong(FrRawElement v, PFrElement a) {
+    memcpy(v, a->longVal, sizeof(FrRawElement));
+}
+
+static inline void storeLong(PFrElement r, const FrRawElement v) {
+    memcpy(r->longVal, v, sizeof(FrRawElement));
+}
+
+static inline void setShort(PFrElement r, int32_t v) {
+    r->shortVal = v;
+    r->type = Fr_SHORT;
+}
+
+static inline void rawFromInt64(FrRawElement r, int64_t v) {
+    if (v >= 0) {
+        r[0] = (uint64_t)v; r[1] = 0; r[2] = 0; r[3] = 0;
+    } else {
+        FrRawElement a = {(uint64_t)(-v), 0, 0, 0};
+        rawSubBorrow(r, Fr_rawq, a);
+    }
+}
+
+static inline void setInt64(PFrElement r, int64_t v) {
+    if (v >= INT32_MIN && v <= INT32_MAX) {
+        setShort(r, (int32_t)v);
+    } else {
+        FrRawElement a;
+        rawFromInt64(a, v);
+        r->shortVal = 0;
+        r->type = Fr_LONG;
+        storeLong(r, a);
+    }
+}
+
+void copy(PFrElement r, PFrElement a) {
+    *r = *a;
+}
+
+void copyn(PFrElement r, PFrElement a, int n) {
+    memmove(r, a, n*sizeof(FrElement));
+}
+
+void toNormal(PFrElement r, PFrElement a) {
+    if (isMontgomery(a)) {
+        FrRawElement m, n;
+        loadLong(m, a);
+        rawFromMontgomery(n, m);
+        r->shortVal = a->shortVal;
+        r->type = Fr_LONG;
+        storeLong(r, n);
+    } else {
+        copy(r, a);
+    }
+}
+
+void toLongNormal(PFrElement r, PFrElement a) {
+    if (!isLong(a)) {
+        int32_t v = a->shortVal;
+        FrRawElement n;
+        rawFromInt64(n, v);
+        r->shortVal = v;
+        r->type = Fr_LONG;
+        storeLong(r, n);
+    } else {
+        toNormal(r, a);
+    }
+}
+
+void toMontgomery(PFrElement r, PFrElement a) {
+    if (isMontgomery(a)) {
+        copy(r, a);
+    } else if (isLong(a)) {
+        FrRawElement n, m;
+        loadLong(n, a);
+        rawToMontgomery(m, n);
+        r->shortVal = a->shortVal;
+        r->type = Fr_LONGMONTGOMERY;
+        storeLong(r, m);
+    } else {
+        int32_t v = a->shortVal;
+        FrRawElement m;
+        if (v >= 0) {
+            rawMMul1(m, R2, (uint64_t)v);
+        } else {
+            FrRawElement p;
+            rawMMul1(p, R2, (uint64_t)(-(int64_t)v));
+            rawNeg(m, p);
+        }
+        r->shortVal = v;
+        r->type = Fr_LONGMONTGOMERY;
+        storeLong(r, m);
+    }
+}
+
+int isTrue(PFrElement pE) {
+    if (!isLong(pE)) return pE->shortVal != 0;
+    FrRawElement v;
+    loadLong(v, pE);
+    return !rawIsZero(v);
+}
+
+int toInt(PFrElement pE) {
+    if (!isLong(pE)) return pE->shortVal;
+    FrElement tmp;
+    FrRawElement v;
+    toNormal(&tmp, pE);
+    loadLong(v, &tmp);
+    if (!(v[0] >> 31) && !v[1] && !v[2] && !v[3]) return (int)v[0];
+    FrRawElement m;
+    if (!rawSubBorrow(m, v, Fr_rawq)) {
+        Fr_fail();
+        return 0;
+    }
+    int64_t r = (int64_t)m[0];
+    if ((r >> 31) != -1) {
+        Fr_fail();
+        return 0;
+    }
+    return (int)r;
+}
+
+// The raw value of a as a long element in normal or Montgomery form.
+static void longNormal(FrRawElement v, PFrElement a) {
+    FrElement l;
+    toLongNormal(&l, a);
+    loadLong(v, &l);
+}
+
+static void longMontgomery(FrRawElement v, PFrElement a) {
+    FrElement l;
+    toMontgomery(&l, a);
+    loadLong(v, &l);
+}
+
+// Brings a and b to a common long representation. Returns true when that is
+// the Montgomery form.
+static bool toCommonLong(PFrElement a, PFrElement b, FrRawElement la, FrRawElement lb) {
+    bool m = isMontgomery(a) || isMontgomery(b);
+    if (m) {
+        longMontgomery(la, a);
+        longMontgomery(lb, b);
+    } else {
+        longNormal(la, a);
+        longNormal(lb, b);
+    }
+    return m;
+}
+
+void add(PFrElement r, PFrElement a, PFrElement b) {
+    if (!isLong(a) && !isLong(b)) {
+        setInt64(r, (int64_t)a->shortVal + (int64_t)b->shortVal);
+        return;
+    }
+    FrRawElement la, lb, v;
+    bool m = toCommonLong(a, b, la, lb);
+    rawAdd(v, la, lb);
+    r->shortVal = 0;
+    r->type = m ? Fr_LONGMONTGOMERY : Fr_LONG;
+    storeLong(r, v);
+}
+
+void sub(PFrElement r, PFrElement a, PFrElement b) {
+    if (!isLong(a) && !isLong(b)) {
+        setInt64(r, (int64_t)a->shortVal - (int64_t)b->shortVal);
+        return;
+    }
+    FrRawElement la, lb, v;
+    bool m = toCommonLong(a, b, la, lb);
+    rawSub(v, la, lb);
+    r->shortVal = 0;
+    r->type = m ? Fr_LONGMONTGOMERY : Fr_LONG;
+    storeLong(r, v);
+}
+
+void neg(PFrElement r, PFrElement a) {
+    if (!isLong(a)) {
+        setInt64(r, -(int64_t)a->shortVal);
+        return;
+    }
+    FrRawElement la, v;
+    loadLong(la, a);
+    rawNeg(v, la);
+    r->shortVal = a->shortVal;
+    r->type = a->type;
+    storeLong(r, v);
+}
+
+void mul(PFrElement r, PFrElement a, PFrElement b) {
+    if (!isLong(a) && !isLong(b)) {
+        setInt64(r, (int64_t)a->shortVal * (int64_t)b->shortVal);
+        return;
+    }
+    // One Montgomery factor and one normal factor give a normal product.
+    FrRawElement ma, mb, v;
+    bool m = isMontgomery(a) || isMontgomery(b);
+    longMontgomery(ma, a);
+    if (m) {
+        longMontgomery(mb, b);
+    } else {
+        longNormal(mb, b);
+    }
+    rawMMul(v, ma, mb);
+    r->shortVal = 0;
+    r->type = m ? Fr_LONGMONTGOMERY : Fr_LONG;
+    storeLong(r, v);
+}
+
+void square(PFrElement r, PFrElement a) {
+    mul(r, a, a);
+}
+
+// Signed view used by the comparison operators: elements above (q-1)/2 are
+// negative.
+static int signedCmp(PFrElement a, PFrElement b) {
+    if (!isLong(a) && !isLong(b)) {
+        return a->shortVal < b->shortVal ? -1 : (a->shortVal > b->shortVal ? 1 : 0);
+    }
+    FrRawElement la, lb;
+    longNormal(la, a);
+    longNormal(lb, b);
+    bool na = rawCmp(la, half) > 0;
+    bool nb = rawCmp(lb, half) > 0;
+    if (na != nb) return na ? -1 : 1;
+    return rawCmp(la, lb);
+}
+
+static void setBool(PFrElement r, int v) {
+    setShort(r, v ? 1 : 0);
+}
+
+void eq(PFrElement r, PFrElement a, PFrElement b) { setBool(r, signedCmp(a, b) == 0); }
+void neq(PFrElement r, PFrElement a, PFrElement b) { setBool(r, signedCmp(a, b) != 0); }
+void lt(PFrElement r, PFrElement a, PFrElement b) { setBool(r, signedCmp(a, b) < 0); }
+void gt(PFrElement r, PFrElement a, PFrElement b) { setBool(r, signedCmp(a, b) > 0); }
+void leq(PFrElement r, PFrElement a, PFrElement b) { setBool(r, signedCmp(a, b) <= 0); }
+void geq(PFrElement r, PFrElement a, PFrElement b) { setBool(r, signedCmp(a, b) >= 0); }
+
+void land(PFrElement r, PFrElement a, PFrElement b) { setBool(r, isTrue(a) && isTrue(b)); }
+void lor(PFrElement r, PFrElement a, PFrElement b) { setBool(r, isTrue(a) || isTrue(b)); }
+void lnot(PFrElement r, PFrElement a) { setBool(r, !isTrue(a)); }
+
+// Bitwise operators work on the canonical value in [0, q) and reduce the
+// result back below q after masking to 254 bits.
+static inline void bitResult(PFrElement r, FrRawElement v) {
+    v[3] &= lboMask;
+    rawReduceOnce(v);
+    r->shortVal = 0;
+    r->type = Fr_LONG;
+    storeLong(r, v);
+}
+
+void band(PFrElement r, PFrElement a, PFrElement b) {
+    if (!isLong(a) && !isLong(b) && a->shortVal >= 0 && b->shortVal >= 0) {
+        setShort(r, a->shortVal & b->shortVal);
+        return;
+    }
+    FrRawElement la, lb, v;
+    longNormal(la, a);
+    longNormal(lb, b);
+    for (int i=0; i<Fr_N64; i++) v[i] = la[i] & lb[i];
+    bitResult(r, v);
+}
+
+void bor(PFrElement r, PFrElement a, PFrElement b) {
+    if (!isLong(a) && !isLong(b) && a->shortVal >= 0 && b->shortVal >= 0) {
+        setShort(r, a->shortVal | b->shortVal);
+        return;
+    }
+    FrRawElement la, lb, v;
+    longNormal(la, a);
+    longNormal(lb, b);
+    for (int i=0; i<Fr_N64; i++) v[i] = la[i] | lb[i];
+    bitResult(r, v);
+}
+
+void bxor(PFrElement r, PFrElement a, PFrElement b) {
+    if (!isLong(a) && !isLong(b) && a->shortVal >= 0 && b->shortVal >= 0) {
+        setShort(r, a->shortVal ^ b->shortVal);
+        return;
+    }
+    FrRawElement la, lb, v;
+    longNormal(la, a);
+    longNormal(lb, b);
+    for (int i=0; i<Fr_N64; i++) v[i] = la[i] ^ lb[i];
+    bitResult(r, v);
+}
+
+void bnot(PFrElement r, PFrElement a) {
+    FrRawElement la, v;
+    longNormal(la, a);
+    for (int i=0; i<Fr_N64; i++) v[i] = ~la[i];
+    bitResult(r, v);
+}
+
+static void rawShr(FrRawElement r, const FrRawElement a, uint32_t n) {
+    uint32_t words = n >> 6, bits = n & 63;
+    for (int i=0; i<Fr_N64; i++) {
+        uint32_t s = i + words;
+        uint64_t lo = s < Fr_N64 ? a[s] : 0;
+        uint64_t hi = s + 1 < Fr_N64 ? a[s+1] : 0;
+        r[i] = bits ? (lo >> bits) | (hi << (64 - bits)) : lo;
+    }
+}
+
+static void rawShl(FrRawElement r, const FrRawElement a, uint32_t n) {
+    uint32_t words = n >> 6, bits = n & 63;
+    for (int i=Fr_N64-1; i>=0; i--) {
+        int s = i - (int)words;
+        uint64_t hi = s >= 0 ? a[s] : 0;
+        uint64_t lo = s - 1 >= 0 ? a[s-1] : 0;
+        r[i] = bits ? (hi << bits) | (lo >> (64 - bits)) : hi;
+    }
+    r[3] &= lboMask;
+    rawReduceOnce(r);
+}
+
+static void doShr(PFrElement r, PFrElement a, uint32_t n) {
+    if (!isLong(a) && a->shortVal >= 0) {
+        setShort(r, n >= 31 ? 0 : a->shortVal >> n);
+        return;
+    }
+    FrRawElement la, v;
+    longNormal(la, a);
+    rawShr(v, la, n);
+    r->shortVal = 0;
+    r->type = Fr_LONG;
+    storeLong(r, v);
+}
+
+static void doShl(PFrElement r, PFrElement a, uint32_t n) {
+    if (!isLong(a) && a->shortVal >= 0 && n < 31) {
+        int64_t v = (int64_t)a->shortVal << n;
+        if (!(v >> 31)) {
+            setShort(r, (int32_t)v);
+            return;
+        }
+    }
+    FrRawElement la, v;
+    longNormal(la, a);
+    rawShl(v, la, n);
+    r->shortVal = 0;
+    r->type = Fr_LONG;
+    storeLong(r, v);
+}
+
+// Decodes the shift amount. Returns false if the result is zero; otherwise
+// sets n and whether the shift goes to the right.
+static bool shiftAmount(PFrElement b, bool right, uint32_t &n, bool &toRight) {
+    if (!isLong(b)) {
+        int32_t v = b->shortVal;
+        toRight = v >= 0 ? right : !right;
+        int64_t m = v >= 0 ? v : -(int64_t)v;
+        if (m >= 254) return false;
+        n = (uint32_t)m;
+        return true;
+    }
+    FrElement lb;
+    FrRawElement v;
+    toNormal(&lb, b);
+    loadLong(v, &lb);
+    if (v[0] < 254 && !v[1] && !v[2] && !v[3]) {
+        n = (uint32_t)v[0];
+        toRight = right;
+        return true;
+    }
+    FrRawElement d;
+    rawSubBorrow(d, Fr_rawq, v);
+    if (d[0] < 254 && !d[1] && !d[2] && !d[3]) {
+        n = (uint32_t)d[0];
+        toRight = !right;
+        return true;
+    }
+    return false;
+}
+
+void shr(PFrElement r, PFrElement a, PFrElement b) {
+    uint32_t n;
+    bool toRight;
+    if (!shiftAmount(b, true, n, toRight)) {
+        setShort(r, 0);
+    } else if (toRight) {
+        doShr(r, a, n);
+    } else {
+        doShl(r, a, n);
+    }
+}
+
+void shl(PFrElement r, PFrElement a, PFrElement b) {
+    uint32_t n;
+    bool toRight;
+    if (!shiftAmount(b, false, n, toRight)) {
+        setShort(r, 0);
+    } else if (toRight) {
+        doShr(r, a, n);
+    } else {
+        doShl(r, a, n);
+    }
+}
+
+static bool supported() {
+    return true;
+}
+
+} // namespace fr_generic
+
+#define FR_GENERIC_ENTRY(ret, name, params, args) fr_generic::name,
+
+const FrBackend Fr_genericBackend = {
+    "generic",
+    fr_generic::supported,
+    FR_BACKEND_FUNCTIONS(FR_GENERIC_ENTRY)
+};
@@ -0,0 +1,96 @@
+#ifndef __FR_INLINE_H
+#define __FR_INLINE_H
+
+#include "fr.hpp"
+
+// Inline fast paths for the Fr_* calls that dominate generated code: copies,
+// loop-counter arithmetic and comparisons on short values, and the isTrue /
+// toInt conversions of loop conditions and array indexes. Short operands are
+// handled here, where the compiler can keep them in registers. Long operands
+// and short results that overflow fall back to the out-of-line backend.
+//
+// The fast paths are the Fr_*Inline functions below; the extern "C" Fr_*
+// functions keep their meaning. Generated circuit code, which cannot be
+// edited, opts in by being compiled with FR_INLINE_CALLS: those names are
+// then redirected to the inline versions in that translation unit only.
+
+static inline bool Fr_isShortInline(PFrElement a) {
+    return !(a->type & Fr_LONG);
+}
+
+static inline void Fr_setShortInline(PFrElement r, int32_t v) {
+    r->shortVal = v;
+    r->type = Fr_SHORT;
+}
+
+static inline void Fr_copyInline(PFrElement r, PFrElement a) {
+    *r = *a;
+}
+
+static inline void Fr_addInline(PFrElement r, PFrElement a, PFrElement b) {
+    if (Fr_isShortInline(a) && Fr_isShortInline(b)) {
+        int64_t v = (int64_t)a->shortVal + b->shortVal;
+        if (v == (int32_t)v) {
+            Fr_setShortInline(r, (int32_t)v);
+            return;
+        }
+    }
+    Fr_add(r, a, b);
+}
+
+static inline void Fr_subInline(PFrElement r, PFrElement a, PFrElement b) {
+    if (Fr_isShortInline(a) && Fr_isShortInline(b)) {
+        int64_t v = (int64_t)a->shortVal - b->shortVal;
+        if (v == (int32_t)v) {
+            Fr_setShortInline(r, (int32_t)v);
+            return;
+        }
+    }
+    Fr_sub(r, a, b);
+}
+
+// Short values compare as the signed integers they hold, which is also how
+// the backends order field elements.
+#define FR_INLINE_COMPARE(name, op) \
+    static inline void Fr_##name##Inline(PFrElement r, PFrElement a, PFrElement b) { \
+        if (Fr_isShortInline(a) && Fr_isShortInline(b)) { \
+            Fr_setShortInline(r, a->shortVal op b->shortVal); \
+            return; \
+        } \
+        Fr_##name(r, a, b); \
+    }
+
+FR_INLINE_COMPARE(eq, ==)
+FR_INLINE_COMPARE(neq, !=)
+FR_INLINE_COMPARE(lt, <)
+FR_INLINE_COMPARE(gt, >)
+FR_INLINE_COMPARE(leq, <=)
+FR_INLINE_COMPARE(geq, >=)
+
+#undef FR_INLINE_COMPARE
+
+static inline int Fr_isTrueInline(PFrElement a) {
+    if (Fr_isShortInline(a)) return a->shortVal != 0;
+    return Fr_isTrue(a);
+}
+
+static inline int Fr_toIntInline(PFrElement a) {
+    if (Fr_isShortInline(a)) return a->shortVal;
+    return Fr_toInt(a);
+}
+
+#ifdef FR_INLINE_CALLS
+#define Fr_copy Fr_copyInline
+#define Fr_add Fr_addInline
+#define Fr_sub Fr_subInline
+#define Fr_eq Fr_eqInline
+#define Fr_neq Fr_neqInline
+#define Fr_lt Fr_ltInline
+#define Fr_gt Fr_gtInline
+#define Fr_leq Fr_leqInline
+#define Fr_geq Fr_geqInline
+#define Fr_isTrue Fr_isTrueInline
+#define Fr_toInt Fr_toIntInline
+#endif // FR_INLINE_CALLS
+
+#endif // __FR_INLINE_H
@@ -0,0 +1,18 @@
+#include "fr_mpz.hpp"
+
+void Fr_toMpz(mpz_t r, PFrElement pE) {
+    FrElement tmp;
+    Fr_toLongNormal(&tmp, pE);
+    mpz_import(r, Fr_N64, -1, 8, -1, 0, (const void *)tmp.longVal);
+}
+
+void Fr_fromMpz(PFrElement pE, const mpz_t v) {
+    if (mpz_fits_sint_p(v)) {
+        pE->type = Fr_SHORT;
+        pE->shortVal = mpz_get_si(v);
+    } else {
+        pE->type = Fr_LONG;
+        for (int i=0; i<Fr_N64; i++) pE->longVal[i] = 0;
+        mpz_export((void *)(pE->longVal), NULL, -1, 8, -1, 0, v);
+    }
+}
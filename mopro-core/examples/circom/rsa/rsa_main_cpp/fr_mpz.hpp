@@ -0,0 +1,30 @@
+#ifndef __FR_MPZ_H
+#define __FR_MPZ_H
+
+#include <gmp.h>
+#include "fr.hpp"
+
+// Conversions between field elements and GMP integers, for debugging and
+// for checking results against a bigint library. The witness calculator
+// itself does not use GMP: build fr_mpz.cpp and link -lgmp only where these
+// are wanted (make BIGINT=gmp).
+
+void Fr_toMpz(mpz_t r, PFrElement pE);
+void Fr_fromMpz(PFrElement pE, const mpz_t v);
+
+template <class Params>
+void Field_toMpz(mpz_t r, Field<Params> &f, const typename Field<Params>::Element &a) {
+    typename Field<Params>::Element tmp;
+    f.fromMontgomery(tmp, a);
+    mpz_import(r, Params::N64, -1, 8, -1, 0, (const void *)tmp.v);
+}
+
+// a must be in [0, 2^(64*N64)).
+template <class Params>
+void Field_fromMpz(Field<Params> &f, typename Field<Params>::Element &r, const mpz_t a) {
+    typename Field<Params>::Element tmp = typename Field<Params>::Element();
+    mpz_export((void *)(tmp.v), NULL, -1, 8, -1, 0, a);
+    f.toMontgomery(r, tmp);
+}
+
+#endif // __FR_MPZ_H
@@ -0,0 +1,449 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <string>
+#include <vector>
+
+#include "fr.hpp"
+#include "fr_backend.hpp"
+
+// Checks the field operations fr.cpp implements itself, on top of the
+// backend primitives, under every backend this CPU runs: the safegcd
+// inversion behind Fr_inv, Fr_rawInv and Fr_batchInv, the integer
+// operations built on rawDivMod and toCanonical, and Fr_pow. The
+// witnesscalc library tests link circom's own fr.cpp and do not cover them. Run with
+// `make test`, which also runs them with assertions compiled out.
+
+static int tests_run = 0;
+static int tests_failed = 0;
+static const char *backend = "";
+
+static FrElement fr_short(int32_t val)
+{
+    return {val, Fr_SHORT, {0, 0, 0, 0}};
+}
+
+static FrElement fr_long(uint64_t val0, uint64_t val1 = 0, uint64_t val2 = 0, uint64_t val3 = 0)
+{
+    return {0, Fr_LONG, {val0, val1, val2, val3}};
+}
+
+static FrElement fr_mlong(uint64_t val0, uint64_t val1 = 0, uint64_t val2 = 0, uint64_t val3 = 0)
+{
+    return {0, Fr_LONGMONTGOMERY, {val0, val1, val2, val3}};
+}
+
+static void print_raw(const char *label, const FrRawElement a)
+{
+    printf("%s: %016llx %016llx %016llx %016llx\n", label,
+           (unsigned long long)a[3], (unsigned long long)a[2],
+           (unsigned long long)a[1], (unsigned long long)a[0]);
+}
+
+static void normal_raw(FrRawElement r, FrElement a)
+{
+    FrElement normal;
+
+    Fr_toLongNormal(&normal, &a);
+    memcpy(r, &normal.longVal, sizeof(FrRawElement));
+}
+
+static bool check_Result(bool passed, int idx, const std::string &test_name)
+{
+    if (!passed) {
+        printf("%s:%d failed on the %s backend\n", test_name.c_str(), idx, backend);
+        tests_failed++;
+    }
+    tests_run++;
+    return passed;
+}
+
+// Compares the normal form of a computed element with a raw value, so the
+// check holds whatever representation the operation chose for its result.
+static void compare_Normal(FrRawElement expected, FrElement computed, FrElement A, int idx, std::string test_name)
+{
+    FrRawElement result, a;
+
+    normal_raw(result, computed);
+    if (!check_Result(Fr_rawIsEq(expected, result), idx, test_name)) {
+        normal_raw(a, A);
+        print_raw("A", a);
+        print_raw("Expected", expected);
+        print_raw("Computed", result);
+    }
+}
+
+static uint64_t xorshift(uint64_t &s)
+{
+    s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+    return s;
+}
+
+// A random value below q of up to limbs limbs, with a random number of bits
+// in the top one, so that inversions of every length are exercised.
+static void random_raw(FrRawElement r, uint64_t &s, int limbs)
+{
+    for (int i=0; i<Fr_N64; i++) r[i] = i < limbs ? xorshift(s) : 0;
+    r[limbs-1] >>= xorshift(s) & 63;
+    r[Fr_N64-1] &= 0x0fffffffffffffff;
+}
+
+static void Fr_inv_test(FrElement a, int index)
+{
+    FrRawElement one = {1, 0, 0, 0};
+    FrElement inverse = {0,0,{0,0,0,0}};
+    FrElement product = {0,0,{0,0,0,0}};
+
+    Fr_inv(&inverse, &a);
+    Fr_mul(&product, &a, &inverse);
+
+    compare_Normal(one, product, a, index, __func__);
+}
+
+static void Fr_inv_unit_test()
+{
+    Fr_inv_test(fr_short(1), 0);
+    Fr_inv_test(fr_short(2), 1);
+    Fr_inv_test(fr_short(-1), 2);
+    Fr_inv_test(fr_short(0x7fffffff), 3);
+    Fr_inv_test(fr_long(0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014), 4);
+    Fr_inv_test(fr_long(0x1bb8e645ae216da7,0x53fe3ab1e35c59e3,0x8c49833d53bb8085,0x0216d0b17f4e44a5), 5);
+    Fr_inv_test(fr_mlong(0x1bb8e645ae216da7,0x53fe3ab1e35c59e3,0x8c49833d53bb8085,0x0216d0b17f4e44a5), 6);
+    Fr_inv_test(fr_long(0x43e1f593f0000000,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029), 7);
+    Fr_inv_test(fr_long(0x0000000000000001,0x0000000000000000,0x0000000000000000,0x0000000000000001), 8);
+
+    // inv(2) = (q+1)/2, q-1 = -1 is its own inverse and 0 maps to 0.
+    FrElement two = fr_short(2);
+    FrElement zero = fr_short(0);
+    FrElement qm1 = fr_long(0x43e1f593f0000000,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029);
+    FrRawElement half = {0xa1f0fac9f8000001,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014};
+    FrRawElement rqm1 = {0x43e1f593f0000000,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029};
+    FrRawElement rzero = {0, 0, 0, 0};
+    FrElement r = {0,0,{0,0,0,0}};
+
+    Fr_inv(&r, &two);
+    compare_Normal(half, r, two, 10, __func__);
+    Fr_inv(&r, &qm1);
+    compare_Normal(rqm1, r, qm1, 11, __func__);
+    Fr_inv(&r, &zero);
+    compare_Normal(rzero, r, zero, 12, __func__);
+    FrElement mzero = fr_mlong(0);
+    Fr_inv(&r, &mzero);
+    compare_Normal(rzero, r, mzero, 13, __func__);
+}
+
+static void Fr_div_unit_test()
+{
+    FrRawElement one = {1, 0, 0, 0};
+    FrRawElement half = {0xa1f0fac9f8000001,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014};
+    FrElement a = fr_long(0x1bb8e645ae216da7,0x53fe3ab1e35c59e3,0x8c49833d53bb8085,0x0216d0b17f4e44a5);
+    FrElement ma = fr_mlong(0x1bb8e645ae216da7,0x53fe3ab1e35c59e3,0x8c49833d53bb8085,0x0216d0b17f4e44a5);
+    FrElement s1 = fr_short(1);
+    FrElement s2 = fr_short(2);
+    FrElement r = {0,0,{0,0,0,0}};
+
+    Fr_div(&r, &a, &a);
+    compare_Normal(one, r, a, 0, __func__);
+    Fr_div(&r, &ma, &ma);
+    compare_Normal(one, r, ma, 1, __func__);
+    Fr_div(&r, &s1, &s2);
+    compare_Normal(half, r, s1, 2, __func__);
+
+    // (a/b)*b = a
+    FrElement q = {0,0,{0,0,0,0}};
+    FrElement back = {0,0,{0,0,0,0}};
+    FrRawElement ra = {0x1bb8e645ae216da7,0x53fe3ab1e35c59e3,0x8c49833d53bb8085,0x0216d0b17f4e44a5};
+    FrElement b = fr_long(0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014);
+    Fr_div(&q, &a, &b);
+    Fr_mul(&back, &q, &b);
+    compare_Normal(ra, back, a, 3, __func__);
+}
+
+// a * a^-1 = 1 in Montgomery form for random a, and q-k for small k.
+static void Fr_rawInv_unit_test()
+{
+    FrRawElement one = {1, 0, 0, 0};
+    FrRawElement mone, a, r, p;
+    uint64_t s = 0x9e3779b97f4a7c15;
+
+    Fr_rawToMontgomery(mone, one);
+    for (int i=0; i<2000; i++) {
+        if (i < 16) {
+            FrRawElement k = {(uint64_t)i + 1, 0, 0, 0};
+            Fr_rawNeg(a, k);
+        } else {
+            random_raw(a, s, 1 + i % Fr_N64);
+            if (Fr_rawIsZero(a)) a[0] = 1;
+        }
+        Fr_rawInv(r, a);
+        Fr_rawMMul(p, a, r);
+        if (!check_Result(Fr_rawIsEq(p, mone), i, __func__)) {
+            print_raw("A", a);
+            print_raw("Inverse", r);
+        }
+    }
+
+    FrRawElement zero = {0, 0, 0, 0};
+    Fr_rawInv(r, zero);
+    check_Result(Fr_rawIsZero(r), 2000, __func__);
+}
+
+// Fr_batchInv matches Fr_inv element by element, zeros included, also when
+// r and a are the same array.
+static void Fr_batchInv_unit_test()
+{
+    const uint n = 37;
+    std::vector<FrElement> a(n), r(n);
+    FrRawElement expected;
+    uint64_t s = 0x2545f4914f6cdd1d;
+
+    for (uint i=0; i<n; i++) {
+        FrRawElement v;
+        random_raw(v, s, 1 + i % Fr_N64);
+        switch (i % 5) {
+        case 0: a[i] = fr_short((int32_t)xorshift(s)); break;
+        case 1: a[i] = fr_long(v[0], v[1], v[2], v[3]); break;
+        case 2: a[i] = fr_mlong(v[0], v[1], v[2], v[3]); break;
+        case 3: a[i] = fr_short(-(int32_t)(i + 1)); break;
+        default: a[i] = (i % 2) ? fr_short(0) : fr_mlong(0); break;
+        }
+    }
+
+    Fr_batchInv(r.data(), a.data(), n);
+    for (uint i=0; i<n; i++) {
+        FrElement inv;
+        Fr_inv(&inv, &a[i]);
+        normal_raw(expected, inv);
+        compare_Normal(expected, r[i], a[i], i, __func__);
+    }
+
+    std::vector<FrElement> c = a;
+    Fr_batchInv(c.data(), c.data(), n);
+    for (uint i=0; i<n; i++) {
+        normal_raw(expected, r[i]);
+        compare_Normal(expected, c[i], a[i], 100 + i, __func__);
+    }
+
+    Fr_batchInv(r.data(), a.data(), 0);
+}
+
+typedef void (*Fr_binop)(PFrElement r, PFrElement a, PFrElement b);
+
+// r = op(a, b), checked by value: expected and r are compared in normal form.
+static void Fr_binop_normal_test(Fr_binop op, FrElement expected, FrElement a, FrElement b, int index, std::string test_name)
+{
+    FrElement r = {0,0,{0,0,0,0}};
+    FrRawElement e;
+
+    op(&r, &a, &b);
+    normal_raw(e, expected);
+    compare_Normal(e, r, a, index, test_name);
+}
+
+#ifndef NDEBUG
+// Whether op(a, b) stops the program. It runs in a child process, so that
+// the assertion in Fr_fail does not end the tests.
+static bool Fr_binop_fails(Fr_binop op, FrElement a, FrElement b)
+{
+    fflush(stdout);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        int null = open("/dev/null", O_WRONLY);
+        if (null >= 0) dup2(null, STDERR_FILENO);
+        FrElement r;
+        op(&r, &a, &b);
+        _exit(0);
+    }
+
+    int status = 0;
+    if (pid < 0 || waitpid(pid, &status, 0) != pid) return false;
+    return !(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+#endif
+
+static void Fr_idiv_unit_test()
+{
+    FrElement la = fr_long(0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014);
+    FrElement lb = fr_long(0x1bb8e645ae216da7,0x53fe3ab1e35c59e3,0x8c49833d53bb8085,0x0216d0b17f4e44a5);
+    FrElement lc = fr_long(0xc4f3c7aba72cc4a3,0xf3b5635824ee2725);
+    FrElement ld = fr_long(0xd10b7a6f3e2c1d0b,0x6e2f0a1d9c3b7e45,0x00e0a7eb8ef62abc,0x2a3c09f0a58a7e85);
+    FrElement lq1 = fr_long(0x43e1f593f0000000,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029);
+    FrElement ma = fr_mlong(0xcba5e0bbd0000003,0x789bb8d96d2c51b3,0x28f0d12384840917,0x112ceb58a394e07d);
+    FrElement mb = fr_mlong(0x5e94d8e1b4bf0040,0x2a489cbe1cfbb6b8,0x893cc664a19fcfed,0x0cf8594b7fcc657c);
+    FrElement mc = fr_mlong(0xa6e9497ef47ad3a4,0x1366259f250d25a5,0x4a5b3511d90ef370,0x2be106d7ab78f672);
+    FrElement md = fr_mlong(0x65e97599b18dcede,0x2c460d28010da351,0x69aac2194023490c,0x2f4f467d3f15f9be);
+
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x3), fr_short(17), fr_short(5), 0, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014), fr_short(-1), fr_short(2), 1, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x0), fr_short(5), fr_short(-1), 2, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x7fff), fr_short(2147483647), fr_short(65536), 3, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0xb), la, lb, 4, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x4e78b3498c3ea0a0,0x196a8e3f1d2635e1), la, lc, 5, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0xc7db585d24fb18c5,0x6302f3b73eee095a,0x196a8e3f1d2635e1), la, fr_long(0xf3b5635824ee2725), 6, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x16a0a73150000000,0xb8114d6d7de87adb,0xe81ac1e7808072c9,0x10216f7ba065e00d), lq1, fr_long(0x3), 7, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014), la, fr_long(0x1), 8, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x50f87d64fc000000,0x4a0cfa121e6e5c24,0x6e14116da0605617,0x0c19139cb84c680a), la, fr_long(0x2), 9, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029), la, fr_long(0x8000000000000000), 10, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014), la, fr_long(0x0000000000000000,0x0000000000000001), 11, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x183227397098d0), la, fr_long(0x0000000000000000,0x0000000000000000,0x0000000000000000,0x0000000000000100), 12, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x1), lq1, fr_long(0x0000000000000000,0x0000000000000000,0x0000000000000000,0x2000000000000000), 13, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x0), lb, la, 14, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x1), la, la, 15, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x4e78b3498c3ea0a0,0x196a8e3f1d2635e1), ma, mc, 16, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x00e0a7eb8ef62abc,0x2a3c09f0a58a7e85), md, fr_long(0x0000000000000000,0x0000000000000000,0x0000000000000001), 17, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x0), fr_short(123456), mb, 18, __func__);
+    Fr_binop_normal_test(Fr_idiv, fr_long(0x0), ld, fr_short(-7), 19, __func__);
+}
+
+static void Fr_mod_unit_test()
+{
+    FrElement la = fr_long(0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014);
+    FrElement lb = fr_long(0x1bb8e645ae216da7,0x53fe3ab1e35c59e3,0x8c49833d53bb8085,0x0216d0b17f4e44a5);
+    FrElement lc = fr_long(0xc4f3c7aba72cc4a3,0xf3b5635824ee2725);
+    FrElement ld = fr_long(0xd10b7a6f3e2c1d0b,0x6e2f0a1d9c3b7e45,0x00e0a7eb8ef62abc,0x2a3c09f0a58a7e85);
+    FrElement lq1 = fr_long(0x43e1f593f0000000,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029);
+    FrElement ma = fr_mlong(0xcba5e0bbd0000003,0x789bb8d96d2c51b3,0x28f0d12384840917,0x112ceb58a394e07d);
+    FrElement mb = fr_mlong(0x5e94d8e1b4bf0040,0x2a489cbe1cfbb6b8,0x893cc664a19fcfed,0x0cf8594b7fcc657c);
+    FrElement mc = fr_mlong(0xa6e9497ef47ad3a4,0x1366259f250d25a5,0x4a5b3511d90ef370,0x2be106d7ab78f672);
+    FrElement md = fr_mlong(0x65e97599b18dcede,0x2c460d28010da351,0x69aac2194023490c,0x2f4f467d3f15f9be);
+
+    Fr_binop_normal_test(Fr_mod, fr_long(0x2), fr_short(17), fr_short(5), 0, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0x0), fr_short(-1), fr_short(2), 1, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0x5), fr_short(5), fr_short(-1), 2, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0xffff), fr_short(2147483647), fr_short(65536), 3, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0x70ff15cb7c9049d3,0xf82d6e7f77e4db86,0xd4ff7f38a7b22673,0x01372f98f83bdcf7), la, lb, 4, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0x221fe329bda53a20,0xc081b2c7ceea1859), la, lc, 5, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0xc1cda10ca3c96887), la, fr_long(0xf3b5635824ee2725), 6, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0x0), lq1, fr_long(0x3), 7, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0x0), la, fr_long(0x1), 8, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0x0), la, fr_long(0x2), 9, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0x21f0fac9f8000000), la, fr_long(0x8000000000000000), 10, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0xa1f0fac9f8000000), la, fr_long(0x0000000000000000,0x0000000000000001), 11, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x0000000000000014), la, fr_long(0x0000000000000000,0x0000000000000000,0x0000000000000000,0x0000000000000100), 12, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0x43e1f593f0000000,0x2833e84879b97091,0xb85045b68181585d,0x10644e72e131a029), lq1, fr_long(0x0000000000000000,0x0000000000000000,0x0000000000000000,0x2000000000000000), 13, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0x1bb8e645ae216da7,0x53fe3ab1e35c59e3,0x8c49833d53bb8085,0x0216d0b17f4e44a5), lb, la, 14, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0x0), la, la, 15, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0x221fe329bda53a20,0xc081b2c7ceea1859), ma, mc, 16, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0xd10b7a6f3e2c1d0b,0x6e2f0a1d9c3b7e45), md, fr_long(0x0000000000000000,0x0000000000000000,0x0000000000000001), 17, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0x1e240), fr_short(123456), mb, 18, __func__);
+    Fr_binop_normal_test(Fr_mod, fr_long(0xd10b7a6f3e2c1d0b,0x6e2f0a1d9c3b7e45,0x00e0a7eb8ef62abc,0x2a3c09f0a58a7e85), ld, fr_short(-7), 19, __func__);
+}
+
+static void Fr_band_canonical_unit_test()
+{
+    FrElement la = fr_long(0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014);
+    FrElement lb = fr_long(0x1bb8e645ae216da7,0x53fe3ab1e35c59e3,0x8c49833d53bb8085,0x0216d0b17f4e44a5);
+    FrElement ld = fr_long(0xd10b7a6f3e2c1d0b,0x6e2f0a1d9c3b7e45,0x00e0a7eb8ef62abc,0x2a3c09f0a58a7e85);
+    FrElement lq1 = fr_long(0x43e1f593f0000000,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029);
+    FrElement ma = fr_mlong(0xcba5e0bbd0000003,0x789bb8d96d2c51b3,0x28f0d12384840917,0x112ceb58a394e07d);
+    FrElement md = fr_mlong(0x65e97599b18dcede,0x2c460d28010da351,0x69aac2194023490c,0x2f4f467d3f15f9be);
+    FrElement mq1 = fr_mlong(0x974bc177a0000006,0xf13771b2da58a367,0x51e1a2470908122e,0x2259d6b14729c0fa);
+
+    Fr_binop_normal_test(Fr_band, fr_long(0xff00f0f), fr_short(2147421967), fr_short(267452415), 0, __func__);
+    Fr_binop_normal_test(Fr_band, fr_long(0x0), fr_short(-1), fr_short(255), 1, __func__);
+    Fr_binop_normal_test(Fr_band, fr_long(0x43e1f593f0000000,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029), fr_short(-1), fr_short(-1), 2, __func__);
+    Fr_binop_normal_test(Fr_band, fr_long(0x01e0f081f0000000,0x0011e00038983000,0x980000920080080c,0x1020063060108000), fr_short(-1), la, 3, __func__);
+    Fr_binop_normal_test(Fr_band, fr_long(0x01b0e241a8000000,0x10183020205c1840,0x8c08021940808004,0x0012003170084004), la, lb, 4, __func__);
+    Fr_binop_normal_test(Fr_band, fr_long(0x43e1f593f0000000,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029), lq1, lq1, 5, __func__);
+    Fr_binop_normal_test(Fr_band, fr_long(0x43e1f593e0000000,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029), lq1, fr_short(-2), 6, __func__);
+    Fr_binop_normal_test(Fr_band, fr_long(0x81007a4938000000,0x040900041c183840,0x002022cb00c0282c,0x0830013020885004), ma, ld, 7, __func__);
+    Fr_binop_normal_test(Fr_band, fr_long(0x4101700330000000,0x2823080818397001,0x004005a28080081c,0x20240870a1002001), mq1, md, 8, __func__);
+    Fr_binop_normal_test(Fr_band, fr_long(0x0), fr_long(0x0), la, 9, __func__);
+}
+
+static void Fr_shr_range_unit_test()
+{
+    FrElement la = fr_long(0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014);
+    FrElement lq1 = fr_long(0x43e1f593f0000000,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029);
+    FrElement ma = fr_mlong(0xcba5e0bbd0000003,0x789bb8d96d2c51b3,0x28f0d12384840917,0x112ceb58a394e07d);
+
+    Fr_binop_normal_test(Fr_shr, fr_long(0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014), la, fr_short(0), 0, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014), la, fr_short(64), 1, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x4a0cfa121e6e5c24,0x6e14116da0605617,0x0c19139cb84c680a), la, fr_short(65), 2, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x1), lq1, fr_short(253), 3, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x0), lq1, fr_short(254), 4, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x0), lq1, fr_short(255), 5, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x0), lq1, fr_short(1000), 6, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x0), la, fr_long(0x0000000000000000,0x0000000000000001), 7, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x0), la, fr_long(0x43e1f593effffed5,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029), 8, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x2), fr_short(1), fr_short(-1), 9, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x0000000000000000,0x0000000000000001), fr_short(1), fr_short(-64), 10, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x0000000000000000,0x0000000000000000,0x0000000000000000,0x2000000000000000), fr_short(1), fr_short(-253), 11, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x0), fr_short(1), fr_short(-254), 12, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x0f87d64fc0000000,0xa0cfa121e6e5c245,0xe14116da06056174,0x019139cb84c680a6), la, fr_short(-3), 13, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x87c3eb27e0000000,0x5067d090f372e122,0x70a08b6d0302b0ba,0x20c89ce5c2634053), lq1, fr_short(-1), 14, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x80000000), fr_short(1073741824), fr_short(-1), 15, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014), fr_short(-1), fr_short(1), 16, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0xb40c0ac2e9419f42,0x97098d014dc2822d,0x0000000001832273), ma, fr_short(100), 17, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x3e1f593f00000000,0x833e84879b970914,0x85045b68181585d2,0x0644e72e131a029b), ma, fr_mlong(0x28d4e69a5000001b,0x3d797fa4d68edf52,0x70775a3fa8a451d3,0x1a94461dc03be466), 18, __func__);
+    Fr_binop_normal_test(Fr_shr, fr_long(0x0), la, fr_long(0x43e1f593efffff04,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029), 19, __func__);
+}
+
+static void Fr_pow_unit_test()
+{
+    FrElement la = fr_long(0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014);
+    FrElement ma = fr_mlong(0xcba5e0bbd0000003,0x789bb8d96d2c51b3,0x28f0d12384840917,0x112ceb58a394e07d);
+
+    Fr_binop_normal_test(Fr_pow, fr_long(0x1), fr_short(3), fr_short(0), 0, __func__);
+    Fr_binop_normal_test(Fr_pow, fr_long(0x1), fr_short(0), fr_short(0), 1, __func__);
+    Fr_binop_normal_test(Fr_pow, fr_long(0x0), fr_short(0), fr_short(5), 2, __func__);
+    Fr_binop_normal_test(Fr_pow, fr_long(0x400), fr_short(2), fr_short(10), 3, __func__);
+    Fr_binop_normal_test(Fr_pow, fr_long(0x0000000000000000,0x0000000000000000,0x0000000000000000,0x2000000000000000), fr_short(2), fr_short(253), 4, __func__);
+    Fr_binop_normal_test(Fr_pow, la, la, fr_short(1), 5, __func__);
+    Fr_binop_normal_test(Fr_pow, fr_long(0xf2e9782ef4000001,0xde26ee365b4b146c,0x4a3c3448e1210245,0x244b3ad628e5381f), la, fr_long(0x2), 6, __func__);
+    Fr_binop_normal_test(Fr_pow, fr_long(0x287c3eb27e000000,0xa5067d090f372e12,0x370a08b6d0302b0b,0x060c89ce5c263405), ma, fr_short(3), 7, __func__);
+    Fr_binop_normal_test(Fr_pow, fr_long(0xa70bebbdbe542ac2,0x093735ea4474020d,0x53fc6d3d2df4e76e,0x03ed85bbc94953a6), la, fr_long(0x10001), 8, __func__);
+    Fr_binop_normal_test(Fr_pow, fr_long(0x1), la, fr_short(-1), 9, __func__);
+}
+
+// Integer division by zero reaches Fr_fail, which asserts. With assertions
+// compiled out Fr_fail returns and the result is zero.
+static void Fr_idiv_zero_unit_test()
+{
+    FrElement a = fr_long(0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014);
+    FrElement zeros[] = { fr_short(0), fr_long(0), fr_mlong(0) };
+    Fr_binop ops[] = { Fr_idiv, Fr_mod };
+
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 3; j++) {
+#ifdef NDEBUG
+            FrElement r = a;
+            FrRawElement zero = {0, 0, 0, 0};
+            ops[i](&r, &a, &zeros[j]);
+            compare_Normal(zero, r, a, i * 10 + j, __func__);
+#else
+            check_Result(Fr_binop_fails(ops[i], a, zeros[j]), i * 10 + j, __func__);
+#endif
+        }
+    }
+}
+
+int main()
+{
+    for (int i=0; Fr_backends[i]; i++) {
+        if (!Fr_backends[i]->supported()) {
+            printf("%s: not supported by this CPU\n", Fr_backends[i]->name);
+            continue;
+        }
+        backend = Fr_backends[i]->name;
+        Fr_useBackend(backend);
+
+        Fr_inv_unit_test();
+        Fr_div_unit_test();
+        Fr_rawInv_unit_test();
+        Fr_batchInv_unit_test();
+        Fr_idiv_unit_test();
+        Fr_mod_unit_test();
+        Fr_idiv_zero_unit_test();
+        Fr_band_canonical_unit_test();
+        Fr_shr_range_unit_test();
+        Fr_pow_unit_test();
+    }
+
+    printf("Results: %d tests were run, %d failed.\n", tests_run, tests_failed);
+    return tests_failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
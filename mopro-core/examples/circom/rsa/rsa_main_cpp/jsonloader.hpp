@@ -0,0 +1,18 @@
+#ifndef __JSONLOADER_H
+#define __JSONLOADER_H
+
+#include <cstddef>
+
+#include "calcwit.hpp"
+
+// Assigns the inputs in the JSON object json[0..size) to ctx in a single
+// pass over the text. Each key names an input signal and its value is a
+// number, a decimal string, a "0b"/"0o"/"0x" prefixed string, or arrays of
+// them nested to any depth, which are flattened in order. Values are parsed
+// straight into blocks of field elements and handed to
+// setInputSignalRangeAt(), so no document tree and no per-signal vector are
+// built. Throws std::runtime_error on malformed input or a value count that
+// does not match the signal size, before the circuit runs.
+void loadJsonBuffer(Circom_CalcWit *ctx, const char *json, size_t size);
+
+#endif // __JSONLOADER_H
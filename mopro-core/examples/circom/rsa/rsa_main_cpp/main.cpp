@@ -2,70 +2,68 @@
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 #include <sys/stat.h>
 #include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
-#include <nlohmann/json.hpp>
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
 #include <vector>
 #include <chrono>
 
-using json = nlohmann::json;
-
 #include "calcwit.hpp"
 #include "circom.hpp"
+#include "jsonloader.hpp"
 
 
 #define handle_error(msg) \
            do { perror(msg); exit(EXIT_FAILURE); } while (0)
 
-Circom_Circuit* loadCircuit(std::string const &datFileName) {
-    Circom_Circuit *circuit = new Circom_Circuit;
-
-    int fd;
-    struct stat sb;
-
-    fd = open(datFileName.c_str(), O_RDONLY);
-    if (fd == -1) {
-        std::cout << ".dat file not found: " << datFileName << "\n";
-        throw std::system_error(errno, std::generic_category(), "open");
-    }
-    
-    if (fstat(fd, &sb) == -1) {          /* To obtain file size */
-        throw std::system_error(errno, std::generic_category(), "fstat");
-    }
-
-    u8* bdata = (u8*)mmap(NULL, sb.st_size, PROT_READ , MAP_PRIVATE, fd, 0);
-    close(fd);
+// Parses the .dat contents in bdata into circuit. With zeroCopy the input
+// hash map, witness list and constants point straight into bdata, which must
+// then stay mapped as long as the circuit is alive.
+void parseCircuit(Circom_Circuit *circuit, u8 *bdata, size_t size, bool zeroCopy) {
+    circuit->zeroCopy = zeroCopy;
 
-    circuit->InputHashMap = new HashSignalInfo[get_size_of_input_hashmap()];
     uint dsize = get_size_of_input_hashmap()*sizeof(HashSignalInfo);
-    memcpy((void *)(circuit->InputHashMap), (void *)bdata, dsize);
+    if (zeroCopy) {
+      circuit->InputHashMap = (HashSignalInfo*)bdata;
+    } else {
+      circuit->InputHashMap = new HashSignalInfo[get_size_of_input_hashmap()];
+      memcpy((void *)(circuit->InputHashMap), (void *)bdata, dsize);
+    }
 
-    circuit->witness2SignalList = new u64[get_size_of_witness()];
     uint inisize = dsize;    
     dsize = get_size_of_witness()*sizeof(u64);
-    memcpy((void *)(circuit->witness2SignalList), (void *)(bdata+inisize), dsize);
+    if (zeroCopy) {
+      circuit->witness2SignalList = (u64*)(bdata+inisize);
+    } else {
+      circuit->witness2SignalList = new u64[get_size_of_witness()];
+      memcpy((void *)(circuit->witness2SignalList), (void *)(bdata+inisize), dsize);
+    }
 
-    circuit->circuitConstants = new FrElement[get_size_of_constants()];
-    if (get_size_of_constants()>0) {
-      inisize += dsize;
-      dsize = get_size_of_constants()*sizeof(FrElement);
-      memcpy((void *)(circuit->circuitConstants), (void *)(bdata+inisize), dsize);
+    inisize += dsize;
+    dsize = get_size_of_constants()*sizeof(FrElement);
+    if (zeroCopy) {
+      circuit->circuitConstants = (FrElement*)(bdata+inisize);
+    } else {
+      circuit->circuitConstants = new FrElement[get_size_of_constants()];
+      if (get_size_of_constants()>0) {
+        memcpy((void *)(circuit->circuitConstants), (void *)(bdata+inisize), dsize);
+      }
     }
 
     std::map<u32,IODefPair> templateInsId2IOSignalInfo1;
     if (get_size_of_io_map()>0) {
-      u32 index[get_size_of_io_map()];
       inisize += dsize;
+      u32* index = (u32*)(bdata+inisize);
       dsize = get_size_of_io_map()*sizeof(u32);
-      memcpy((void *)index, (void *)(bdata+inisize), dsize);
       inisize += dsize;
       assert(inisize % sizeof(u32) == 0);    
-      assert(sb.st_size % sizeof(u32) == 0);
-      u32 dataiomap[(sb.st_size-inisize)/sizeof(u32)];
-      memcpy((void *)dataiomap, (void *)(bdata+inisize), sb.st_size-inisize);
-      u32* pu32 = dataiomap;
+      assert(size % sizeof(u32) == 0);
+      u32* pu32 = (u32*)(bdata+inisize);
 
       for (int i = 0; i < get_size_of_io_map(); i++) {
 	u32 n = *pu32;
@@ -89,168 +87,227 @@ Circom_Circuit* loadCircuit(std::string const &datFileName) {
       }
     }
     circuit->templateInsId2IOSignalInfo = move(templateInsId2IOSignalInfo1);
-    
-    munmap(bdata, sb.st_size);
-    
-    return circuit;
 }
 
-bool check_valid_number(std::string & s, uint base){
-  bool is_valid = true;
-  if (base == 16){
-    for (uint i = 0; i < s.size(); i++){
-      is_valid &= (
-        ('0' <= s[i] && s[i] <= '9') || 
-        ('a' <= s[i] && s[i] <= 'f') ||
-        ('A' <= s[i] && s[i] <= 'F')
-      );
+u8* mapDatFile(std::string const &datFileName, size_t &size) {
+    int fd;
+    struct stat sb;
+
+    fd = open(datFileName.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::cout << ".dat file not found: " << datFileName << "\n";
+        throw std::system_error(errno, std::generic_category(), "open");
     }
-  } else{
-    for (uint i = 0; i < s.size(); i++){
-      is_valid &= ('0' <= s[i] && s[i] < char(int('0') + base));
+    
+    if (fstat(fd, &sb) == -1) {          /* To obtain file size */
+        close(fd);
+        throw std::system_error(errno, std::generic_category(), "fstat");
     }
-  }
-  return is_valid;
-}
 
-void json2FrElements (json val, std::vector<FrElement> & vval){
-  if (!val.is_array()) {
-    FrElement v;
-    std::string s_aux, s;
-    uint base;
-    if (val.is_string()) {
-      s_aux = val.get<std::string>();
-      std::string possible_prefix = s_aux.substr(0, 2);
-      if (possible_prefix == "0b" || possible_prefix == "0B"){
-        s = s_aux.substr(2, s_aux.size() - 2);
-        base = 2; 
-      } else if (possible_prefix == "0o" || possible_prefix == "0O"){
-        s = s_aux.substr(2, s_aux.size() - 2);
-        base = 8; 
-      } else if (possible_prefix == "0x" || possible_prefix == "0X"){
-        s = s_aux.substr(2, s_aux.size() - 2);
-        base = 16;
-      } else{
-        s = s_aux;
-        base = 10;
-      }
-      if (!check_valid_number(s, base)){
-        std::ostringstream errStrStream;
-        errStrStream << "Invalid number in JSON input: " << s_aux << "\n";
-	      throw std::runtime_error(errStrStream.str() );
-      }
-    } else if (val.is_number()) {
-        double vd = val.get<double>();
-        std::stringstream stream;
-        stream << std::fixed << std::setprecision(0) << vd;
-        s = stream.str();
-        base = 10;
-    } else {
-        std::ostringstream errStrStream;
-        errStrStream << "Invalid JSON type\n";
-	      throw std::runtime_error(errStrStream.str() );
-    }
-    Fr_str2element (&v, s.c_str(), base);
-    vval.push_back(v);
-  } else {
-    for (uint i = 0; i < val.size(); i++) {
-      json2FrElements (val[i], vval);
+    u8* bdata = (u8*)mmap(NULL, sb.st_size, PROT_READ , MAP_SHARED, fd, 0);
+    close(fd);
+    if (bdata == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "mmap");
     }
-  }
+
+    size = sb.st_size;
+    return bdata;
+}
+
+Circom_Circuit* loadCircuit(std::string const &datFileName) {
+    Circom_Circuit *circuit = new Circom_Circuit;
+
+    size_t size;
+    u8* bdata = mapDatFile(datFileName, size);
+
+    parseCircuit(circuit, bdata, size, false);
+    
+    munmap(bdata, size);
+    
+    return circuit;
 }
 
+// Zero-copy variant of loadCircuit: the circuit executes directly out of a
+// read-only shared mapping of the .dat file, so processes running the same
+// circuit share one page-cache copy of it. The mapping is released by the
+// circuit destructor.
+Circom_Circuit* mapCircuit(std::string const &datFileName) {
+    Circom_Circuit *circuit = new Circom_Circuit;
+
+    size_t size;
+    u8* bdata = mapDatFile(datFileName, size);
+    madvise(bdata, size, MADV_WILLNEED);
+
+    parseCircuit(circuit, bdata, size, true);
+    circuit->mappedData = bdata;
+    circuit->mappedSize = size;
+
+    return circuit;
+}
 
+// Maps the input file and streams it into ctx with loadJsonBuffer().
 void loadJson(Circom_CalcWit *ctx, std::string filename) {
-  std::ifstream inStream(filename);
-  json j;
-  inStream >> j;
-  
-  u64 nItems = j.size();
-  // printf("Items : %llu\n",nItems);
-  if (nItems == 0){
-    ctx->tryRunCircuit();
-  }
-  for (json::iterator it = j.begin(); it != j.end(); ++it) {
-    // std::cout << it.key() << " => " << it.value() << '\n';
-    u64 h = fnv1a(it.key());
-    std::vector<FrElement> v;
-    json2FrElements(it.value(),v);
-    uint signalSize = ctx->getInputSignalSize(h);
-    if (v.size() < signalSize) {
-	std::ostringstream errStrStream;
-	errStrStream << "Error loading signal " << it.key() << ": Not enough values\n";
-	throw std::runtime_error(errStrStream.str() );
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::cout << "Input file not found: " << filename << "\n";
+        throw std::system_error(errno, std::generic_category(), "open");
     }
-    if (v.size() > signalSize) {
-	std::ostringstream errStrStream;
-	errStrStream << "Error loading signal " << it.key() << ": Too many values\n";
-	throw std::runtime_error(errStrStream.str() );
+
+    struct stat sb;
+    if (fstat(fd, &sb) == -1) {
+        close(fd);
+        throw std::system_error(errno, std::generic_category(), "fstat");
     }
-    for (uint i = 0; i<v.size(); i++){
-      try {
-	// std::cout << it.key() << "," << i << " => " << Fr_element2str(&(v[i])) << '\n';
-	ctx->setInputSignal(h,i,v[i]);
-      } catch (std::runtime_error e) {
-	std::ostringstream errStrStream;
-	errStrStream << "Error setting signal: " << it.key() << "\n" << e.what();
-	throw std::runtime_error(errStrStream.str() );
-      }
+
+    size_t size = sb.st_size;
+    if (size == 0) {
+        close(fd);
+        loadJsonBuffer(ctx, "", 0);
+        return;
     }
-  }
+
+    char *json = (char*)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (json == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+    madvise(json, size, MADV_SEQUENTIAL);
+
+    try {
+        loadJsonBuffer(ctx, json, size);
+    } catch (...) {
+        munmap(json, size);
+        throw;
+    }
+    munmap(json, size);
 }
 
-void writeBinWitness(Circom_CalcWit *ctx, std::string wtnsFileName) {
-    FILE *write_ptr;
+// Writes the header and the witness into wtns, which holds
+// getBinWitnessSize() bytes. With montgomery the witness is in Montgomery
+// form and its section has id 3 instead of 2, so readers of the standard
+// format reject it instead of reading wrong values.
+void storeBinWitness(Circom_CalcWit *ctx, char *wtns, bool montgomery) {
+    u32 n8 = Fr_N64*8;
+    uint Nwtns = get_size_of_witness();
 
-    write_ptr = fopen(wtnsFileName.c_str(),"wb");
+    char *p = wtns;
+    auto put = [&p](const void *data, size_t size) {
+        memcpy(p, data, size);
+        p += size;
+    };
 
-    fwrite("wtns", 4, 1, write_ptr);
+    put("wtns", 4);
 
     u32 version = 2;
-    fwrite(&version, 4, 1, write_ptr);
+    put(&version, 4);
 
     u32 nSections = 2;
-    fwrite(&nSections, 4, 1, write_ptr);
+    put(&nSections, 4);
 
     // Header
     u32 idSection1 = 1;
-    fwrite(&idSection1, 4, 1, write_ptr);
-
-    u32 n8 = Fr_N64*8;
+    put(&idSection1, 4);
 
     u64 idSection1length = 8 + n8;
-    fwrite(&idSection1length, 8, 1, write_ptr);
+    put(&idSection1length, 8);
 
-    fwrite(&n8, 4, 1, write_ptr);
+    put(&n8, 4);
 
-    fwrite(Fr_q.longVal, Fr_N64*8, 1, write_ptr);
+    put(Fr_q.longVal, Fr_N64*8);
 
-    uint Nwtns = get_size_of_witness();
-    
     u32 nVars = (u32)Nwtns;
-    fwrite(&nVars, 4, 1, write_ptr);
+    put(&nVars, 4);
 
     // Data
-    u32 idSection2 = 2;
-    fwrite(&idSection2, 4, 1, write_ptr);
-    
+    u32 idSection2 = montgomery ? 3 : 2;
+    put(&idSection2, 4);
+
     u64 idSection2length = (u64)n8*(u64)Nwtns;
-    fwrite(&idSection2length, 8, 1, write_ptr);
+    put(&idSection2length, 8);
 
-    FrElement v;
+    ctx->getWitnessBytes(0, Nwtns, p, montgomery);
+}
 
-    for (int i=0;i<Nwtns;i++) {
-        ctx->getWitness(i, &v);
-        Fr_toLongNormal(&v, &v);
-        fwrite(v.longVal, Fr_N64*8, 1, write_ptr);
+size_t getBinWitnessSize() {
+    return 44 + (size_t)Fr_N64*8 * (get_size_of_witness() + 1);
+}
+
+// Allocates the first size bytes of fd, which also become its length. A
+// store to a mapped page the file system cannot allocate, on a full disk,
+// raises SIGBUS, so the blocks have to exist before the file is mapped.
+static bool allocateFile(int fd, size_t size) {
+#ifdef __APPLE__
+    fstore_t store = {F_ALLOCATEALL, F_PEOFPOSMODE, 0, (off_t)size, 0};
+    return fcntl(fd, F_PREALLOCATE, &store) != -1 && ftruncate(fd, size) == 0;
+#else
+    return posix_fallocate(fd, 0, size) == 0;
+#endif
+}
+
+// Sizes the file up front and serializes the witness straight into a shared
+// mapping of it. Outputs that cannot be mapped, like pipes, get the same
+// bytes from a heap buffer in as few write() calls as the kernel allows.
+// On failure the partial file is removed, but only if the name is the
+// regular file itself and not, say, /dev/stdout.
+void writeBinWitness(Circom_CalcWit *ctx, std::string wtnsFileName, bool montgomery) {
+    size_t size = getBinWitnessSize();
+
+    int fd = open(wtnsFileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1)
+        handle_error("open");
+
+    struct stat sb, lsb;
+    bool removable = fstat(fd, &sb) == 0 && S_ISREG(sb.st_mode) &&
+                     lstat(wtnsFileName.c_str(), &lsb) == 0 &&
+                     sb.st_dev == lsb.st_dev && sb.st_ino == lsb.st_ino;
+    auto discard = [&]() {
+        int err = errno;
+        if (removable) unlink(wtnsFileName.c_str());
+        errno = err;
+    };
+
+    try {
+        if (allocateFile(fd, size)) {
+            void *wtns = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (wtns != MAP_FAILED) {
+                storeBinWitness(ctx, (char*)wtns, montgomery);
+                munmap(wtns, size);
+                close(fd);
+                return;
+            }
+            // Drop what was allocated; write() extends the file again.
+            if (ftruncate(fd, 0) == -1) {
+                discard();
+                handle_error("ftruncate");
+            }
+        }
+
+        std::vector<char> wtns(size);
+        storeBinWitness(ctx, wtns.data(), montgomery);
+        for (size_t done = 0; done < size; ) {
+            ssize_t n = write(fd, wtns.data() + done, size - done);
+            if (n == -1) {
+                if (errno == EINTR) continue;
+                discard();
+                handle_error("write");
+            }
+            done += n;
+        }
+    } catch (...) {
+        discard();
+        throw;
+    }
+    if (close(fd) == -1) {
+        discard();
+        handle_error("close");
     }
-    fclose(write_ptr);
 }
 
 int main (int argc, char *argv[]) {
   std::string cl(argv[0]);
-  if (argc!=3) {
-        std::cout << "Usage: " << cl << " <input.json> <output.wtns>\n";
+  bool montgomery = argc == 4 && std::string(argv[3]) == "--montgomery";
+  if (argc!=3 && !montgomery) {
+        std::cout << "Usage: " << cl << " <input.json> <output.wtns> [--montgomery]\n";
   } else {
     std::string datfile = cl + ".dat";
     std::string jsonfile(argv[1]);
@@ -258,27 +315,32 @@ int main (int argc, char *argv[]) {
   
     // auto t_start = std::chrono::high_resolution_clock::now();
 
-   Circom_Circuit *circuit = loadCircuit(datfile);
+   try {
+     Circom_Circuit *circuit = mapCircuit(datfile);
 
-   Circom_CalcWit *ctx = new Circom_CalcWit(circuit);
-  
-   loadJson(ctx, jsonfile);
-   if (ctx->getRemaingInputsToBeSet()!=0) {
-     std::cerr << "Not all inputs have been set. Only " << get_main_input_signal_no()-ctx->getRemaingInputsToBeSet() << " out of " << get_main_input_signal_no() << std::endl;
-     assert(false);
-   }
-   /*
-     for (uint i = 0; i<get_size_of_witness(); i++){
-     FrElement x;
-     ctx->getWitness(i, &x);
-     std::cout << i << ": " << Fr_element2str(&x) << std::endl;
-     }
-   */
-  
-   //auto t_mid = std::chrono::high_resolution_clock::now();
-   //std::cout << std::chrono::duration<double, std::milli>(t_mid-t_start).count()<<std::endl;
+     Circom_CalcWit *ctx = new Circom_CalcWit(circuit);
 
-   writeBinWitness(ctx,wtnsfile);
+     loadJson(ctx, jsonfile);
+     if (ctx->getRemaingInputsToBeSet()!=0) {
+       std::cerr << "Not all inputs have been set. Only " << get_main_input_signal_no()-ctx->getRemaingInputsToBeSet() << " out of " << get_main_input_signal_no() << std::endl;
+       return EXIT_FAILURE;
+     }
+     /*
+       for (uint i = 0; i<get_size_of_witness(); i++){
+       FrElement x;
+       ctx->getWitness(i, &x);
+       std::cout << i << ": " << Fr_element2str(&x) << std::endl;
+       }
+     */
+
+     //auto t_mid = std::chrono::high_resolution_clock::now();
+     //std::cout << std::chrono::duration<double, std::milli>(t_mid-t_start).count()<<std::endl;
+
+     writeBinWitness(ctx,wtnsfile,montgomery);
+   } catch (std::exception &e) {
+     std::cerr << e.what() << '\n';
+     return EXIT_FAILURE;
+   }
   
    //auto t_end = std::chrono::high_resolution_clock::now();
    //std::cout << std::chrono::duration<double, std::milli>(t_end-t_mid).count()<<std::endl;
@@ -3,35 +3,35 @@
 #include <assert.h>
 #include "circom.hpp"
 #include "calcwit.hpp"
-void Num2Bits_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void Num2Bits_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void Num2Bits_0_run(uint ctx_index,Circom_CalcWit* ctx);
-void IsZero_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void IsZero_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void IsZero_1_run(uint ctx_index,Circom_CalcWit* ctx);
-void Bits2Num_2_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void Bits2Num_2_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void Bits2Num_2_run(uint ctx_index,Circom_CalcWit* ctx);
-void RSAPad_3_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void RSAPad_3_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void RSAPad_3_run(uint ctx_index,Circom_CalcWit* ctx);
-void Num2Bits_4_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void Num2Bits_4_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void Num2Bits_4_run(uint ctx_index,Circom_CalcWit* ctx);
-void LessThan_5_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void LessThan_5_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void LessThan_5_run(uint ctx_index,Circom_CalcWit* ctx);
-void IsEqual_6_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void IsEqual_6_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void IsEqual_6_run(uint ctx_index,Circom_CalcWit* ctx);
-void AND_7_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void AND_7_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void AND_7_run(uint ctx_index,Circom_CalcWit* ctx);
-void OR_8_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void OR_8_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void OR_8_run(uint ctx_index,Circom_CalcWit* ctx);
-void BigLessThan_9_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void BigLessThan_9_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void BigLessThan_9_run(uint ctx_index,Circom_CalcWit* ctx);
-void Num2Bits_10_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void Num2Bits_10_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void Num2Bits_10_run(uint ctx_index,Circom_CalcWit* ctx);
-void CheckCarryToZero_11_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void CheckCarryToZero_11_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void CheckCarryToZero_11_run(uint ctx_index,Circom_CalcWit* ctx);
-void FpMul_12_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void FpMul_12_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void FpMul_12_run(uint ctx_index,Circom_CalcWit* ctx);
-void FpPow65537Mod_13_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void FpPow65537Mod_13_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void FpPow65537Mod_13_run(uint ctx_index,Circom_CalcWit* ctx);
-void RSAVerify65537_14_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void RSAVerify65537_14_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void RSAVerify65537_14_run(uint ctx_index,Circom_CalcWit* ctx);
 void poly_eval_0(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size);
 void poly_interp_1(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size);
@@ -77,6 +77,46 @@ NULL,
 NULL,
 NULL,
 NULL };
+const char* _templateNameTable[15] = { 
+"Num2Bits",
+"IsZero",
+"Bits2Num",
+"RSAPad",
+"Num2Bits",
+"LessThan",
+"IsEqual",
+"AND",
+"OR",
+"BigLessThan",
+"Num2Bits",
+"CheckCarryToZero",
+"FpMul",
+"FpPow65537Mod",
+"RSAVerify65537" };
+const u32 _componentNameDimensions[14] = {32,32,220,32,32,32,31,31,31,63,32,32,16,32};
+const Circom_ComponentName _componentNameTable[22] = { 
+{"main",0,NULL},
+{"modulus_n2b",1,&_componentNameDimensions[0]},
+{"base_message_n2b",1,&_componentNameDimensions[1]},
+{"modulus_zero",1,&_componentNameDimensions[2]},
+{"padded_message_b2n",1,&_componentNameDimensions[3]},
+{"n2b",0,NULL},
+{"isz",0,NULL},
+{"lt",1,&_componentNameDimensions[4]},
+{"eq",1,&_componentNameDimensions[5]},
+{"ors",1,&_componentNameDimensions[6]},
+{"ands",1,&_componentNameDimensions[7]},
+{"eq_ands",1,&_componentNameDimensions[8]},
+{"carryRangeChecks",1,&_componentNameDimensions[9]},
+{"q_range_check",1,&_componentNameDimensions[10]},
+{"r_range_check",1,&_componentNameDimensions[11]},
+{"tCheck",0,NULL},
+{"doublers",1,&_componentNameDimensions[12]},
+{"adder",0,NULL},
+{"padder",0,NULL},
+{"signatureRangeCheck",1,&_componentNameDimensions[13]},
+{"bigLessThan",0,NULL},
+{"bigPow",0,NULL} };
 uint get_main_input_signal_start() {return 1;}
 
 uint get_main_input_signal_no() {return 96;}
@@ -93,27 +133,22 @@ uint get_size_of_constants() {return 209;}
 
 uint get_size_of_io_map() {return 0;}
 
+const char* get_template_name(uint templateId) {return _templateNameTable[templateId];}
+
+const Circom_ComponentName* get_component_name(uint nameId) {return &_componentNameTable[nameId];}
+
 void release_memory_component(Circom_CalcWit* ctx, uint pos) {{
 
 if (pos != 0){{
 
 if(ctx->componentMemory[pos].subcomponents)
-delete []ctx->componentMemory[pos].subcomponents;
+CIRCOM_DELETE_COMPONENT_ARRAY(ctx->componentMemory[pos].subcomponents);
 
 if(ctx->componentMemory[pos].subcomponentsParallel)
-delete []ctx->componentMemory[pos].subcomponentsParallel;
-
-if(ctx->componentMemory[pos].outputIsSet)
-delete []ctx->componentMemory[pos].outputIsSet;
-
-if(ctx->componentMemory[pos].mutexes)
-delete []ctx->componentMemory[pos].mutexes;
-
-if(ctx->componentMemory[pos].cvs)
-delete []ctx->componentMemory[pos].cvs;
+CIRCOM_DELETE_COMPONENT_ARRAY(ctx->componentMemory[pos].subcomponentsParallel);
 
 if(ctx->componentMemory[pos].sbct)
-delete []ctx->componentMemory[pos].sbct;
+CIRCOM_DELETE_COMPONENT_ARRAY(ctx->componentMemory[pos].sbct);
 
 }}
 
@@ -125,7 +160,7 @@ delete []ctx->componentMemory[pos].sbct;
 void poly_eval_0(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size){
 FrElement* circuitConstants = ctx->circuitConstants;
 FrElement expaux[7];
-std::string myTemplateName = "poly_eval";
+const char* myTemplateName = "poly_eval";
 u64 myId = componentFather;
 {
 PFrElement aux_dest = &lvar[34];
@@ -167,7 +202,7 @@ return;
 void poly_interp_1(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size){
 FrElement* circuitConstants = ctx->circuitConstants;
 FrElement expaux[5];
-std::string myTemplateName = "poly_interp";
+const char* myTemplateName = "poly_interp";
 u64 myId = componentFather;
 Fr_leq(&expaux[0],&lvar[0],&circuitConstants[26]); // line circom 78
 if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 78. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
@@ -2773,7 +2808,7 @@ return;
 void getProperRepresentation_2(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size){
 FrElement* circuitConstants = ctx->circuitConstants;
 FrElement expaux[9];
-std::string myTemplateName = "getProperRepresentation";
+const char* myTemplateName = "getProperRepresentation";
 u64 myId = componentFather;
 {
 
@@ -3514,7 +3549,7 @@ return;
 void long_div_3(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size){
 FrElement* circuitConstants = ctx->circuitConstants;
 FrElement expaux[5];
-std::string myTemplateName = "long_div";
+const char* myTemplateName = "long_div";
 u64 myId = componentFather;
 {
 PFrElement aux_dest = &lvar[435];
@@ -9214,7 +9249,7 @@ return;
 void div_ceil_4(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size){
 FrElement* circuitConstants = ctx->circuitConstants;
 FrElement expaux[4];
-std::string myTemplateName = "div_ceil";
+const char* myTemplateName = "div_ceil";
 u64 myId = componentFather;
 {
 PFrElement aux_dest = &lvar[2];
@@ -9250,7 +9285,7 @@ return;
 void short_div_5(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size){
 FrElement* circuitConstants = ctx->circuitConstants;
 FrElement expaux[7];
-std::string myTemplateName = "short_div";
+const char* myTemplateName = "short_div";
 u64 myId = componentFather;
 {
 PFrElement aux_dest = &lvar[234];
@@ -9362,7 +9397,7 @@ return;
 void long_scalar_mult_6(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size){
 FrElement* circuitConstants = ctx->circuitConstants;
 FrElement expaux[7];
-std::string myTemplateName = "long_scalar_mult";
+const char* myTemplateName = "long_scalar_mult";
 u64 myId = componentFather;
 {
 PFrElement aux_dest = &lvar[35];
@@ -10037,7 +10072,7 @@ return;
 void long_sub_7(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size){
 FrElement* circuitConstants = ctx->circuitConstants;
 FrElement expaux[7];
-std::string myTemplateName = "long_sub";
+const char* myTemplateName = "long_sub";
 u64 myId = componentFather;
 {
 PFrElement aux_dest = &lvar[402];
@@ -11338,7 +11373,7 @@ return;
 void long_scalar_mult_8(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size){
 FrElement* circuitConstants = ctx->circuitConstants;
 FrElement expaux[7];
-std::string myTemplateName = "long_scalar_mult";
+const char* myTemplateName = "long_scalar_mult";
 u64 myId = componentFather;
 {
 PFrElement aux_dest = &lvar[203];
@@ -12013,7 +12048,7 @@ return;
 void short_div_norm_9(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size){
 FrElement* circuitConstants = ctx->circuitConstants;
 FrElement expaux[7];
-std::string myTemplateName = "short_div_norm";
+const char* myTemplateName = "short_div_norm";
 u64 myId = componentFather;
 {
 PFrElement aux_dest = &lvar[402];
@@ -12147,7 +12182,7 @@ return;
 void long_gt_10(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size){
 FrElement* circuitConstants = ctx->circuitConstants;
 FrElement expaux[3];
-std::string myTemplateName = "long_gt";
+const char* myTemplateName = "long_gt";
 u64 myId = componentFather;
 {
 PFrElement aux_dest = &lvar[302];
@@ -12187,7 +12222,7 @@ return;
 void long_sub_11(Circom_CalcWit* ctx,FrElement* lvar,uint componentFather,FrElement* destination,int destination_size){
 FrElement* circuitConstants = ctx->circuitConstants;
 FrElement expaux[7];
-std::string myTemplateName = "long_sub";
+const char* myTemplateName = "long_sub";
 u64 myId = componentFather;
 {
 PFrElement aux_dest = &lvar[302];
@@ -13486,21 +13521,19 @@ return;
 }
 
 // template declarations
-void Num2Bits_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void Num2Bits_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 0;
-ctx->componentMemory[coffset].templateName = "Num2Bits";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 1;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 0);
 }
 
 void Num2Bits_0_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -13548,7 +13581,7 @@ Fr_copy(aux_dest,&expaux[0]);
 Fr_sub(&expaux[3],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&circuitConstants[2]); // line circom 33
 Fr_mul(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&expaux[3]); // line circom 33
 Fr_eq(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 33
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(0) << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 {
 PFrElement aux_dest = &lvar[1];
@@ -13575,7 +13608,7 @@ Fr_copy(aux_dest,&expaux[0]);
 Fr_lt(&expaux[0],&lvar[3],&circuitConstants[0]); // line circom 31
 }
 Fr_eq(&expaux[0],&lvar[1],&signalValues[mySignalStart + 64]); // line circom 38
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(0) << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 for (uint i = 0; i < 0; i++){
 uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
@@ -13583,21 +13616,19 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void IsZero_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void IsZero_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 1;
-ctx->componentMemory[coffset].templateName = "IsZero";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 1;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 0);
 }
 
 void IsZero_1_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -13636,7 +13667,7 @@ Fr_copy(aux_dest,&expaux[0]);
 }
 Fr_mul(&expaux[1],&signalValues[mySignalStart + 1],&signalValues[mySignalStart + 0]); // line circom 33
 Fr_eq(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 33
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(1) << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 for (uint i = 0; i < 0; i++){
 uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
@@ -13644,21 +13675,19 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void Bits2Num_2_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void Bits2Num_2_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 2;
-ctx->componentMemory[coffset].templateName = "Bits2Num";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 64;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 0);
 }
 
 void Bits2Num_2_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -13731,21 +13760,19 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void RSAPad_3_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void RSAPad_3_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 3;
-ctx->componentMemory[coffset].templateName = "RSAPad";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 64;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[316]{0};
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 316);
 }
 
 void RSAPad_3_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -13772,10 +13799,8 @@ Fr_copy(aux_dest,&circuitConstants[0]);
 uint aux_create = 0;
 int aux_cmp_num = 32+ctx_index+1;
 uint csoffset = mySignalStart+8320;
-uint aux_dimensions[1] = {32};
 for (uint i = 0; i < 32; i++) {
-std::string new_cmp_name = "modulus_n2b"+ctx->generate_position_array(aux_dimensions, 1, i);
-Num2Bits_0_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_0_create(csoffset,aux_cmp_num,ctx,1,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 65 ;
 aux_cmp_num += 1;
@@ -13785,10 +13810,8 @@ aux_cmp_num += 1;
 uint aux_create = 32;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+6240;
-uint aux_dimensions[1] = {32};
 for (uint i = 0; i < 32; i++) {
-std::string new_cmp_name = "base_message_n2b"+ctx->generate_position_array(aux_dimensions, 1, i);
-Num2Bits_0_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_0_create(csoffset,aux_cmp_num,ctx,2,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 65 ;
 aux_cmp_num += 1;
@@ -13798,12 +13821,10 @@ aux_cmp_num += 1;
 uint aux_create = 64;
 int aux_cmp_num = 64+ctx_index+1;
 uint csoffset = mySignalStart+10400;
-uint aux_dimensions[1] = {220};
 uint aux_positions [219]= {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,57,58,59,60,61,62,63,64,65,66,67,68,69,70,71,72,73,74,75,76,77,78,79,80,81,82,83,84,85,86,87,88,89,90,91,92,93,94,95,96,97,98,99,100,101,102,103,104,105,106,107,108,109,110,111,112,113,114,115,116,117,118,119,120,121,122,123,124,125,126,127,128,129,130,131,132,133,134,135,136,137,138,139,140,141,142,143,144,145,146,147,148,149,150,151,152,153,154,155,156,157,158,159,160,161,162,163,164,165,166,167,168,169,170,171,172,173,174,175,176,177,178,179,180,181,182,183,184,185,186,187,188,189,190,191,192,193,194,195,196,197,198,199,200,201,202,203,204,205,206,207,208,209,210,211,212,213,214,215,216,217,218};
 for (uint i_aux = 0; i_aux < 219; i_aux++) {
 uint i = aux_positions[i_aux];
-std::string new_cmp_name = "modulus_zero"+ctx->generate_position_array(aux_dimensions, 1, i);
-IsZero_1_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+IsZero_1_create(csoffset,aux_cmp_num,ctx,3,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 3 ;
 aux_cmp_num += 1;
@@ -13813,10 +13834,8 @@ aux_cmp_num += 1;
 uint aux_create = 284;
 int aux_cmp_num = 283+ctx_index+1;
 uint csoffset = mySignalStart+11057;
-uint aux_dimensions[1] = {32};
 for (uint i = 0; i < 32; i++) {
-std::string new_cmp_name = "padded_message_b2n"+ctx->generate_position_array(aux_dimensions, 1, i);
-Bits2Num_2_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Bits2Num_2_create(csoffset,aux_cmp_num,ctx,4,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 65 ;
 aux_cmp_num += 1;
@@ -13934,7 +13953,7 @@ Fr_copy(aux_dest,&circuitConstants[5]);
 Fr_lt(&expaux[0],&lvar[4],&circuitConstants[6]); // line circom 72
 while(Fr_isTrue(&expaux[0])){
 Fr_eq(&expaux[0],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 4192)],&circuitConstants[1]); // line circom 73
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 73. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(3) << " line 73. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 {
 PFrElement aux_dest = &lvar[4];
@@ -14098,7 +14117,7 @@ Fr_copy(aux_dest,&expaux[0]);
 }
 Fr_geq(&expaux[0],&lvar[5],&circuitConstants[7]); // line circom 91
 }
-if (!Fr_isTrue(&circuitConstants[2])) std::cout << "Failed assert in template/function " << myTemplateName << " line 109. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&circuitConstants[2])) std::cout << "Failed assert in template/function " << get_template_name(3) << " line 109. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&circuitConstants[2]));
 {
 PFrElement aux_dest = &lvar[4];
@@ -14109,7 +14128,7 @@ Fr_copy(aux_dest,&circuitConstants[7]);
 Fr_lt(&expaux[0],&lvar[4],&circuitConstants[11]); // line circom 110
 while(Fr_isTrue(&expaux[0])){
 Fr_eq(&expaux[0],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 96)],&circuitConstants[2]); // line circom 111
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 111. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(3) << " line 111. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 {
 PFrElement aux_dest = &lvar[4];
@@ -14180,21 +14199,19 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void Num2Bits_4_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void Num2Bits_4_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 4;
-ctx->componentMemory[coffset].templateName = "Num2Bits";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 1;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 0);
 }
 
 void Num2Bits_4_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -14242,7 +14259,7 @@ Fr_copy(aux_dest,&expaux[0]);
 Fr_sub(&expaux[3],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&circuitConstants[2]); // line circom 33
 Fr_mul(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&expaux[3]); // line circom 33
 Fr_eq(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 33
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(4) << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 {
 PFrElement aux_dest = &lvar[1];
@@ -14269,7 +14286,7 @@ Fr_copy(aux_dest,&expaux[0]);
 Fr_lt(&expaux[0],&lvar[3],&circuitConstants[12]); // line circom 31
 }
 Fr_eq(&expaux[0],&lvar[1],&signalValues[mySignalStart + 65]); // line circom 38
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(4) << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 for (uint i = 0; i < 0; i++){
 uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
@@ -14277,21 +14294,19 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void LessThan_5_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void LessThan_5_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 5;
-ctx->componentMemory[coffset].templateName = "LessThan";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 2;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[1]{0};
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 1);
 }
 
 void LessThan_5_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -14313,14 +14328,13 @@ uint aux_create = 0;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+3;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "n2b";
-Num2Bits_4_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_4_create(csoffset,aux_cmp_num,ctx,5,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 66 ;
 aux_cmp_num += 1;
 }
 }
-if (!Fr_isTrue(&circuitConstants[2])) std::cout << "Failed assert in template/function " << myTemplateName << " line 90. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&circuitConstants[2])) std::cout << "Failed assert in template/function " << get_template_name(5) << " line 90. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&circuitConstants[2]));
 {
 uint cmp_index_ref = 0;
@@ -14350,21 +14364,19 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void IsEqual_6_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void IsEqual_6_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 6;
-ctx->componentMemory[coffset].templateName = "IsEqual";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 2;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[1]{0};
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 1);
 }
 
 void IsEqual_6_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -14380,8 +14392,7 @@ uint aux_create = 0;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+3;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "isz";
-IsZero_1_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+IsZero_1_create(csoffset,aux_cmp_num,ctx,6,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 3 ;
 aux_cmp_num += 1;
@@ -14413,21 +14424,19 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void AND_7_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void AND_7_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 7;
-ctx->componentMemory[coffset].templateName = "AND";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 2;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 0);
 }
 
 void AND_7_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -14451,21 +14460,19 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void OR_8_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void OR_8_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 8;
-ctx->componentMemory[coffset].templateName = "OR";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 2;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 0);
 }
 
 void OR_8_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -14491,21 +14498,19 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void BigLessThan_9_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void BigLessThan_9_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 9;
-ctx->componentMemory[coffset].templateName = "BigLessThan";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 64;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[157]{0};
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 157);
 }
 
 void BigLessThan_9_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -14532,10 +14537,8 @@ Fr_copy(aux_dest,&circuitConstants[0]);
 uint aux_create = 0;
 int aux_cmp_num = 126+ctx_index+1;
 uint csoffset = mySignalStart+443;
-uint aux_dimensions[1] = {32};
 for (uint i = 0; i < 32; i++) {
-std::string new_cmp_name = "lt"+ctx->generate_position_array(aux_dimensions, 1, i);
-LessThan_5_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+LessThan_5_create(csoffset,aux_cmp_num,ctx,7,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 69 ;
 aux_cmp_num += 2;
@@ -14545,10 +14548,8 @@ aux_cmp_num += 2;
 uint aux_create = 32;
 int aux_cmp_num = 31+ctx_index+1;
 uint csoffset = mySignalStart+158;
-uint aux_dimensions[1] = {32};
 for (uint i = 0; i < 32; i++) {
-std::string new_cmp_name = "eq"+ctx->generate_position_array(aux_dimensions, 1, i);
-IsEqual_6_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+IsEqual_6_create(csoffset,aux_cmp_num,ctx,8,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 6 ;
 aux_cmp_num += 2;
@@ -14558,10 +14559,8 @@ aux_cmp_num += 2;
 uint aux_create = 64;
 int aux_cmp_num = 190+ctx_index+1;
 uint csoffset = mySignalStart+2651;
-uint aux_dimensions[1] = {31};
 for (uint i = 0; i < 31; i++) {
-std::string new_cmp_name = "ors"+ctx->generate_position_array(aux_dimensions, 1, i);
-OR_8_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+OR_8_create(csoffset,aux_cmp_num,ctx,9,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 3 ;
 aux_cmp_num += 1;
@@ -14571,10 +14570,8 @@ aux_cmp_num += 1;
 uint aux_create = 95;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+65;
-uint aux_dimensions[1] = {31};
 for (uint i = 0; i < 31; i++) {
-std::string new_cmp_name = "ands"+ctx->generate_position_array(aux_dimensions, 1, i);
-AND_7_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+AND_7_create(csoffset,aux_cmp_num,ctx,10,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 3 ;
 aux_cmp_num += 1;
@@ -14584,10 +14581,8 @@ aux_cmp_num += 1;
 uint aux_create = 126;
 int aux_cmp_num = 95+ctx_index+1;
 uint csoffset = mySignalStart+350;
-uint aux_dimensions[1] = {31};
 for (uint i = 0; i < 31; i++) {
-std::string new_cmp_name = "eq_ands"+ctx->generate_position_array(aux_dimensions, 1, i);
-AND_7_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+AND_7_create(csoffset,aux_cmp_num,ctx,11,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 3 ;
 aux_cmp_num += 1;
@@ -14867,21 +14862,19 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void Num2Bits_10_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void Num2Bits_10_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 10;
-ctx->componentMemory[coffset].templateName = "Num2Bits";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 1;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 0);
 }
 
 void Num2Bits_10_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -14929,7 +14922,7 @@ Fr_copy(aux_dest,&expaux[0]);
 Fr_sub(&expaux[3],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&circuitConstants[2]); // line circom 33
 Fr_mul(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&expaux[3]); // line circom 33
 Fr_eq(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 33
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(10) << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 {
 PFrElement aux_dest = &lvar[1];
@@ -14956,7 +14949,7 @@ Fr_copy(aux_dest,&expaux[0]);
 Fr_lt(&expaux[0],&lvar[3],&circuitConstants[16]); // line circom 31
 }
 Fr_eq(&expaux[0],&lvar[1],&signalValues[mySignalStart + 75]); // line circom 38
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(10) << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 for (uint i = 0; i < 0; i++){
 uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
@@ -14964,21 +14957,19 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void CheckCarryToZero_11_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void CheckCarryToZero_11_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 11;
-ctx->componentMemory[coffset].templateName = "CheckCarryToZero";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 63;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[63]{0};
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 63);
 }
 
 void CheckCarryToZero_11_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -15011,18 +15002,16 @@ Fr_copy(aux_dest,&circuitConstants[0]);
 uint aux_create = 0;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+126;
-uint aux_dimensions[1] = {63};
 uint aux_positions [62]= {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,57,58,59,60,61};
 for (uint i_aux = 0; i_aux < 62; i_aux++) {
 uint i = aux_positions[i_aux];
-std::string new_cmp_name = "carryRangeChecks"+ctx->generate_position_array(aux_dimensions, 1, i);
-Num2Bits_10_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_10_create(csoffset,aux_cmp_num,ctx,12,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 76 ;
 aux_cmp_num += 1;
 }
 }
-if (!Fr_isTrue(&circuitConstants[2])) std::cout << "Failed assert in template/function " << myTemplateName << " line 537. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&circuitConstants[2])) std::cout << "Failed assert in template/function " << get_template_name(11) << " line 537. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&circuitConstants[2]));
 {
 PFrElement aux_dest = &lvar[3];
@@ -15030,7 +15019,7 @@ PFrElement aux_dest = &lvar[3];
 // end load src
 Fr_copy(aux_dest,&circuitConstants[19]);
 }
-if (!Fr_isTrue(&circuitConstants[2])) std::cout << "Failed assert in template/function " << myTemplateName << " line 541. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&circuitConstants[2])) std::cout << "Failed assert in template/function " << get_template_name(11) << " line 541. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&circuitConstants[2]));
 {
 PFrElement aux_dest = &lvar[4];
@@ -15051,7 +15040,7 @@ Fr_copy(aux_dest,&expaux[0]);
 }
 Fr_mul(&expaux[2],&signalValues[mySignalStart + 63],&circuitConstants[13]); // line circom 551
 Fr_eq(&expaux[0],&signalValues[mySignalStart + 0],&expaux[2]); // line circom 551
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 551. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(11) << " line 551. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 }else{
 {
@@ -15067,7 +15056,7 @@ Fr_sub(&expaux[3],&lvar[4],&circuitConstants[2]); // line circom 555
 Fr_add(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 0)],&signalValues[mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 63)]); // line circom 555
 Fr_mul(&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 63)],&circuitConstants[13]); // line circom 555
 Fr_eq(&expaux[0],&expaux[1],&expaux[2]); // line circom 555
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 555. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(11) << " line 555. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 }
 {
@@ -15096,7 +15085,7 @@ Fr_lt(&expaux[0],&lvar[4],&circuitConstants[20]); // line circom 547
 }
 Fr_add(&expaux[1],&signalValues[mySignalStart + 62],&signalValues[mySignalStart + 124]); // line circom 560
 Fr_eq(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 560
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 560. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(11) << " line 560. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 for (uint i = 0; i < 63; i++){
 uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
@@ -15104,21 +15093,20 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void FpMul_12_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void FpMul_12_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 12;
-ctx->componentMemory[coffset].templateName = "FpMul";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 96;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[65]{0};
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 65);
+ctx->componentMemory[coffset].sbct = CIRCOM_NEW_COMPONENT_ARRAY(ctx, Circom_Future, 65);
 }
 
 void FpMul_12_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -15145,10 +15133,8 @@ Fr_copy(aux_dest,&circuitConstants[0]);
 uint aux_create = 0;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+381;
-uint aux_dimensions[1] = {32};
 for (uint i = 0; i < 32; i++) {
-std::string new_cmp_name = "q_range_check"+ctx->generate_position_array(aux_dimensions, 1, i);
-Num2Bits_0_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_0_create(csoffset,aux_cmp_num,ctx,13,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 65 ;
 aux_cmp_num += 1;
@@ -15158,10 +15144,8 @@ aux_cmp_num += 1;
 uint aux_create = 32;
 int aux_cmp_num = 32+ctx_index+1;
 uint csoffset = mySignalStart+2461;
-uint aux_dimensions[1] = {32};
 for (uint i = 0; i < 32; i++) {
-std::string new_cmp_name = "r_range_check"+ctx->generate_position_array(aux_dimensions, 1, i);
-Num2Bits_0_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_0_create(csoffset,aux_cmp_num,ctx,14,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 65 ;
 aux_cmp_num += 1;
@@ -15172,14 +15156,13 @@ uint aux_create = 64;
 int aux_cmp_num = 64+ctx_index+1;
 uint csoffset = mySignalStart+4541;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "tCheck";
-CheckCarryToZero_11_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+CheckCarryToZero_11_create(csoffset,aux_cmp_num,ctx,15,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 4838 ;
 aux_cmp_num += 63;
 }
 }
-if (!Fr_isTrue(&circuitConstants[2])) std::cout << "Failed assert in template/function " << myTemplateName << " line 27. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&circuitConstants[2])) std::cout << "Failed assert in template/function " << get_template_name(12) << " line 27. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&circuitConstants[2]));
 {
 PFrElement aux_dest = &lvar[2];
@@ -15320,7 +15303,7 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[602])) + 191
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-Num2Bits_0_run(mySubcomponents[cmp_index_ref],ctx);
+ctx->threadPool.submit(Num2Bits_0_run,mySubcomponents[cmp_index_ref],ctx,&ctx->componentMemory[ctx_index].sbct[cmp_index_ref]);
 
 }
 }
@@ -15340,7 +15323,7 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[602])) + 223
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-Num2Bits_0_run(mySubcomponents[cmp_index_ref],ctx);
+ctx->threadPool.submit(Num2Bits_0_run,mySubcomponents[cmp_index_ref],ctx,&ctx->componentMemory[ctx_index].sbct[cmp_index_ref]);
 
 }
 }
@@ -15522,26 +15505,27 @@ Fr_copy(aux_dest,&expaux[0]);
 Fr_lt(&expaux[0],&lvar[802],&circuitConstants[3]); // line circom 82
 }
 for (uint i = 0; i < 65; i++){
+ctx->threadPool.wait(ctx->componentMemory[ctx_index].sbct[i]);
+}
+for (uint i = 0; i < 65; i++){
 uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
 if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void FpPow65537Mod_13_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void FpPow65537Mod_13_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 13;
-ctx->componentMemory[coffset].templateName = "FpPow65537Mod";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 64;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[17]{0};
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 17);
 }
 
 void FpPow65537Mod_13_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -15568,10 +15552,8 @@ Fr_copy(aux_dest,&circuitConstants[0]);
 uint aux_create = 0;
 int aux_cmp_num = 128+ctx_index+1;
 uint csoffset = mySignalStart+9475;
-uint aux_dimensions[1] = {16};
 for (uint i = 0; i < 16; i++) {
-std::string new_cmp_name = "doublers"+ctx->generate_position_array(aux_dimensions, 1, i);
-FpMul_12_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+FpMul_12_create(csoffset,aux_cmp_num,ctx,16,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 9379 ;
 aux_cmp_num += 128;
@@ -15582,8 +15564,7 @@ uint aux_create = 16;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+96;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "adder";
-FpMul_12_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+FpMul_12_create(csoffset,aux_cmp_num,ctx,17,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 9379 ;
 aux_cmp_num += 128;
@@ -15849,21 +15830,19 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 }
 
-void RSAVerify65537_14_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void RSAVerify65537_14_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 14;
-ctx->componentMemory[coffset].templateName = "RSAVerify65537";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 96;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[35]{0};
+ctx->componentMemory[coffset].subcomponents = CIRCOM_NEW_COMPONENT_ARRAY(ctx, uint, 35);
 }
 
 void RSAVerify65537_14_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -15891,8 +15870,7 @@ uint aux_create = 0;
 int aux_cmp_num = 2399+ctx_index+1;
 uint csoffset = mySignalStart+162379;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "padder";
-RSAPad_3_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+RSAPad_3_create(csoffset,aux_cmp_num,ctx,18,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 13137 ;
 aux_cmp_num += 316;
@@ -15902,10 +15880,8 @@ aux_cmp_num += 316;
 uint aux_create = 1;
 int aux_cmp_num = 2715+ctx_index+1;
 uint csoffset = mySignalStart+175516;
-uint aux_dimensions[1] = {32};
 for (uint i = 0; i < 32; i++) {
-std::string new_cmp_name = "signatureRangeCheck"+ctx->generate_position_array(aux_dimensions, 1, i);
-Num2Bits_0_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_0_create(csoffset,aux_cmp_num,ctx,19,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 65 ;
 aux_cmp_num += 1;
@@ -15916,8 +15892,7 @@ uint aux_create = 33;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+96;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "bigLessThan";
-BigLessThan_9_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+BigLessThan_9_create(csoffset,aux_cmp_num,ctx,20,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 2744 ;
 aux_cmp_num += 222;
@@ -15928,8 +15903,7 @@ uint aux_create = 34;
 int aux_cmp_num = 222+ctx_index+1;
 uint csoffset = mySignalStart+2840;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "bigPow";
-FpPow65537Mod_13_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+FpPow65537Mod_13_create(csoffset,aux_cmp_num,ctx,21,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 159539 ;
 aux_cmp_num += 2177;
@@ -16036,7 +16010,7 @@ Fr_copy(aux_dest,&expaux[0]);
 Fr_lt(&expaux[0],&lvar[2],&circuitConstants[3]); // line circom 138
 }
 Fr_eq(&expaux[0],&ctx->signalValues[ctx->componentMemory[mySubcomponents[33]].signalStart + 0],&circuitConstants[2]); // line circom 144
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 144. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(14) << " line 144. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 {
 PFrElement aux_dest = &lvar[2];
@@ -16090,7 +16064,7 @@ Fr_copy(aux_dest,&circuitConstants[1]);
 Fr_lt(&expaux[0],&lvar[2],&circuitConstants[3]); // line circom 153
 while(Fr_isTrue(&expaux[0])){
 Fr_eq(&expaux[0],&ctx->signalValues[ctx->componentMemory[mySubcomponents[34]].signalStart + ((1 * Fr_toInt(&lvar[2])) + 0)],&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + ((1 * Fr_toInt(&lvar[2])) + 0)]); // line circom 154
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 154. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << get_template_name(14) << " line 154. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
 {
 PFrElement aux_dest = &lvar[2];
@@ -16108,7 +16082,7 @@ if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
 
 void run(Circom_CalcWit* ctx){
-RSAVerify65537_14_create(1,0,ctx,"main",0);
+RSAVerify65537_14_create(1,0,ctx,0,0,0);
 RSAVerify65537_14_run(0,ctx);
 }
 
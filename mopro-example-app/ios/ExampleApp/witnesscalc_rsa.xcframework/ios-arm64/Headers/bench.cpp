@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "witnesscalc.h"
+#include "filemaploader.hpp"
+#include "fr.hpp"
+
+// Measures what the Montgomery witness output saves a prover end to end:
+// computing and serializing the witness, then bringing it into the
+// Montgomery form the prover multiplies in. A normal .wtns has to be
+// converted element by element on load; a Montgomery one is used as is.
+
+typedef std::chrono::high_resolution_clock Clock;
+
+struct Timing {
+    std::vector<double> calc;
+    std::vector<double> load;
+};
+
+double ms(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+double median(std::vector<double> v)
+{
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+// What a prover does with the data section of the .wtns in wtns: out
+// receives its Fr_N64 limbs per witness in Montgomery form.
+void loadWitness(const std::vector<char> &wtns, bool montgomery, std::vector<uint64_t> &out)
+{
+    const char *data = wtns.data() + 44 + Fr_N64*8;
+    size_t n = out.size() / Fr_N64;
+
+    if (montgomery) {
+        memcpy(out.data(), data, n * sizeof(FrRawElement));
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        FrRawElement a;
+        memcpy(a, data + i * sizeof(FrRawElement), sizeof(FrRawElement));
+        Fr_rawToMontgomery(&out[i * Fr_N64], a);
+    }
+}
+
+int main (int argc, char *argv[]) {
+
+    std::string cl(argv[0]);
+
+    if (argc != 3 && argc != 4) {
+        std::cout << "Usage: " << cl << " <circuit.dat> <input.json|input.bin> [iterations]\n";
+        return EXIT_FAILURE;
+    }
+
+    int iterations = argc == 4 ? atoi(argv[3]) : 5;
+    if (iterations < 1) {
+        iterations = 1;
+    }
+
+    CIRCUIT_NAME::witnesscalc_circuit *circuit = NULL;
+
+    try {
+        std::string datfile(argv[1]);
+        std::string inputfile(argv[2]);
+
+        char errorMessage[256];
+
+        int error = CIRCUIT_NAME::witnesscalc_circuit_load_from_dat_file(datfile.c_str(), &circuit,
+                                errorMessage, sizeof(errorMessage));
+        if (error) {
+            std::cerr << errorMessage << '\n';
+            return EXIT_FAILURE;
+        }
+
+        FileMapLoader input(inputfile);
+        bool binInput = inputfile.size() > 4 &&
+                        inputfile.compare(inputfile.size() - 4, 4, ".bin") == 0;
+
+        unsigned long witnessSize = 0;
+        CIRCUIT_NAME::witnesscalc_with_circuit(circuit, "", 0, NULL, &witnessSize, NULL, 0);
+
+        size_t nWitness = (witnessSize - 44) / (Fr_N64*8) - 1;
+        std::vector<char> wtns(witnessSize);
+        std::vector<uint64_t> proverWitness(nWitness * Fr_N64);
+        std::vector<uint64_t> reference;
+
+        Timing timings[2];
+
+        for (int i = 0; i < iterations; i++) {
+            for (int mode = 0; mode < 2; mode++) {
+                unsigned int flags = mode ? WITNESSCALC_WTNS_MONTGOMERY : WITNESSCALC_WTNS_NORMAL;
+                unsigned long size = witnessSize;
+
+                auto start = Clock::now();
+                if (binInput) {
+                    error = CIRCUIT_NAME::witnesscalc_bin_with_circuit_flags(circuit,
+                                input.buffer, input.size, flags,
+                                wtns.data(), &size,
+                                errorMessage, sizeof(errorMessage));
+                } else {
+                    error = CIRCUIT_NAME::witnesscalc_with_circuit_flags(circuit,
+                                input.buffer, input.size, flags,
+                                wtns.data(), &size,
+                                errorMessage, sizeof(errorMessage));
+                }
+                auto calcEnd = Clock::now();
+                if (error) {
+                    std::cerr << errorMessage << '\n';
+                    CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+                    return EXIT_FAILURE;
+                }
+
+                loadWitness(wtns, mode == 1, proverWitness);
+                auto loadEnd = Clock::now();
+
+                timings[mode].calc.push_back(ms(start, calcEnd));
+                timings[mode].load.push_back(ms(calcEnd, loadEnd));
+
+                // Both modes must hand the prover the same elements.
+                if (i == 0 && mode == 0) {
+                    reference = proverWitness;
+                } else if (i == 0 && reference != proverWitness) {
+                    std::cerr << "Montgomery witness does not match the normal one\n";
+                    CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+
+        std::cout << nWitness << " witnesses, median of " << iterations << " runs (ms)\n"
+                  << std::left << std::setw(12) << "wtns" << std::right
+                  << std::setw(10) << "calc" << std::setw(10) << "load"
+                  << std::setw(10) << "total" << '\n'
+                  << std::fixed << std::setprecision(3);
+
+        const char *names[2] = {"normal", "montgomery"};
+        double total[2];
+        for (int mode = 0; mode < 2; mode++) {
+            double calc = median(timings[mode].calc);
+            double load = median(timings[mode].load);
+            total[mode] = calc + load;
+            std::cout << std::left << std::setw(12) << names[mode] << std::right
+                      << std::setw(10) << calc << std::setw(10) << load
+                      << std::setw(10) << total[mode] << '\n';
+        }
+        std::cout << "saved " << total[0] - total[1] << " ms per witness\n";
+
+    } catch (std::exception* e) {
+        std::cerr << e->what() << '\n';
+        CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+        return EXIT_FAILURE;
+
+    } catch (std::exception& e) {
+        std::cerr << e.what() << '\n';
+        CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+        return EXIT_FAILURE;
+    }
+
+    CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include "bininput.hpp"
+
+namespace CIRCUIT_NAME {
+
+namespace {
+
+const uint Block = 256;
+
+u64 fnv1aBytes(u64 hash, const void *data, size_t size) {
+  const unsigned char *p = (const unsigned char *)data;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= u64(p[i]);
+    hash *= 0x100000001B3LL;
+  }
+  return hash;
+}
+
+bool isReduced(const FrRawElement a) {
+  for (int i = Fr_N64 - 1; i >= 0; i--) {
+    if (a[i] != Fr_q.longVal[i]) return a[i] < Fr_q.longVal[i];
+  }
+  return false;
+}
+
+void binInputError(const std::string &msg) {
+  throw std::runtime_error("Invalid binary input: " + msg);
+}
+
+u32 readU32(const char *p) {
+  u32 v;
+  memcpy(&v, p, 4);
+  return v;
+}
+
+} // namespace
+
+u64 binInputFingerprint(const Circom_Circuit *circuit) {
+  u64 hash = 0xCBF29CE484222325LL;
+  u32 n8 = Fr_N64*8;
+  hash = fnv1aBytes(hash, &n8, 4);
+  hash = fnv1aBytes(hash, Fr_q.longVal, n8);
+  u32 start = get_main_input_signal_start();
+  u32 n = get_main_input_signal_no();
+  hash = fnv1aBytes(hash, &start, 4);
+  hash = fnv1aBytes(hash, &n, 4);
+  for (uint i = 0; i < get_size_of_input_hashmap(); i++) {
+    const HashSignalInfo &info = circuit->InputHashMap[i];
+    if (info.hash == 0) continue;
+    hash = fnv1aBytes(hash, &info, sizeof(HashSignalInfo));
+  }
+  return hash;
+}
+
+unsigned long getBinInputSize() {
+  return BinInputHeaderSize + (unsigned long)Fr_N64*8 * get_main_input_signal_no();
+}
+
+void loadBinInput(Circom_CalcWit *ctx, const Circom_Circuit *circuit, const char *buffer, unsigned long size) {
+  u32 n8 = Fr_N64*8;
+  uint n = get_main_input_signal_no();
+
+  if (size < BinInputHeaderSize || memcmp(buffer, "winp", 4) != 0) {
+    binInputError("bad magic");
+  }
+  if (readU32(buffer + 4) != BinInputVersion) {
+    binInputError("unsupported version");
+  }
+  if (readU32(buffer + 8) != n8) {
+    binInputError("element size does not match the field");
+  }
+  u32 flags = readU32(buffer + 12);
+  if (flags & ~WITNESSCALC_BIN_MONTGOMERY) {
+    binInputError("unknown flags");
+  }
+  u64 fingerprint;
+  memcpy(&fingerprint, buffer + 16, 8);
+  if (fingerprint != binInputFingerprint(circuit)) {
+    binInputError("encoded for a different circuit");
+  }
+  if (readU32(buffer + 24) != n || size != getBinInputSize()) {
+    binInputError("wrong number of inputs");
+  }
+
+  // A circuit without inputs runs as soon as it is loaded, as with "{}"
+  // in JSON: there is no last input assignment to start it.
+  if (n == 0) {
+    ctx->tryRunCircuit();
+    return;
+  }
+
+  const char *p = buffer + BinInputHeaderSize;
+  u32 type = (flags & WITNESSCALC_BIN_MONTGOMERY) ? Fr_LONGMONTGOMERY : Fr_LONG;
+  u64 start = get_main_input_signal_start();
+  FrElement v[Block];
+
+  for (uint i = 0; i < n; i += Block) {
+    uint m = std::min(Block, n - i);
+    for (uint j = 0; j < m; j++, p += n8) {
+      v[j].shortVal = 0;
+      v[j].type = type;
+      memcpy(v[j].longVal, p, n8);
+      if (!isReduced(v[j].longVal)) {
+        std::ostringstream stream;
+        stream << "input " << i + j << " is not reduced";
+        binInputError(stream.str());
+      }
+    }
+    ctx->setInputSignalRangeAt(start + i, v, m);
+  }
+}
+
+void storeBinInputHeader(const Circom_Circuit *circuit, u32 flags, char *buffer) {
+  u32 n8 = Fr_N64*8;
+  u32 n = get_main_input_signal_no();
+  u32 reserved = 0;
+  u64 fingerprint = binInputFingerprint(circuit);
+
+  memcpy(buffer, "winp", 4);
+  memcpy(buffer + 4, &BinInputVersion, 4);
+  memcpy(buffer + 8, &n8, 4);
+  memcpy(buffer + 12, &flags, 4);
+  memcpy(buffer + 16, &fingerprint, 8);
+  memcpy(buffer + 24, &n, 4);
+  memcpy(buffer + 28, &reserved, 4);
+}
+
+void storeBinInput(const Circom_Circuit *circuit, const FrElement *inputs, u32 flags, char *buffer) {
+  u32 n8 = Fr_N64*8;
+  u32 n = get_main_input_signal_no();
+
+  storeBinInputHeader(circuit, flags, buffer);
+
+  char *p = buffer + BinInputHeaderSize;
+  for (u32 i = 0; i < n; i++, p += n8) {
+    FrElement a = inputs[i];
+    FrElement r;
+    Fr_toLongNormal(&r, &a);
+    if (flags & WITNESSCALC_BIN_MONTGOMERY) {
+      FrRawElement m;
+      Fr_rawToMontgomery(m, r.longVal);
+      memcpy(p, m, n8);
+    } else {
+      memcpy(p, r.longVal, n8);
+    }
+  }
+}
+
+} // namespace
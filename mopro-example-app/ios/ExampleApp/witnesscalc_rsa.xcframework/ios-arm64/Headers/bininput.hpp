@@ -0,0 +1,58 @@
+#ifndef BININPUT_HPP
+#define BININPUT_HPP
+
+#include "calcwit.hpp"
+#include "witnesscalc.h"
+
+namespace CIRCUIT_NAME {
+
+/**
+ * Binary input format: a 32 byte header followed by one little-endian
+ * element of n8 bytes per input signal, in signal id order.
+ *
+ *   offset  size  field
+ *        0     4  magic "winp"
+ *        4     4  version, 1
+ *        8     4  n8, bytes per element
+ *       12     4  flags, WITNESSCALC_BIN_MONTGOMERY if the elements are
+ *                 in Montgomery form
+ *       16     8  fingerprint of the circuit inputs, see binInputFingerprint()
+ *       24     4  number of elements, get_main_input_signal_no()
+ *       28     4  reserved, 0
+ *
+ * Every element must be smaller than the field modulus.
+ */
+
+const u32 BinInputVersion    = 1;
+const u32 BinInputHeaderSize = 32;
+
+/**
+ * Hash of the input hash map (names, signal ids and sizes) and the field,
+ * so inputs encoded for another circuit are rejected.
+ */
+u64 binInputFingerprint(const Circom_Circuit *circuit);
+
+unsigned long getBinInputSize();
+
+/**
+ * Checks the header of buffer against circuit and assigns every input
+ * signal of ctx from it, which runs the circuit. Throws std::runtime_error
+ * if they do not match.
+ */
+void loadBinInput(Circom_CalcWit *ctx, const Circom_Circuit *circuit, const char *buffer, unsigned long size);
+
+/**
+ * Writes the BinInputHeaderSize bytes of header for circuit to buffer.
+ */
+void storeBinInputHeader(const Circom_Circuit *circuit, u32 flags, char *buffer);
+
+/**
+ * Encodes inputs[0..get_main_input_signal_no()) into buffer, which must hold
+ * getBinInputSize() bytes. flags is WITNESSCALC_BIN_NORMAL or
+ * WITNESSCALC_BIN_MONTGOMERY.
+ */
+void storeBinInput(const Circom_Circuit *circuit, const FrElement *inputs, u32 flags, char *buffer);
+
+} // namespace
+
+#endif // BININPUT_HPP
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -34,16 +36,16 @@ std::string int_to_hex( u64 i )
   return stream.str();
 }
 
-u64 fnv1a(std::string s) {
+u64 fnv1a(const std::string &s) {
   u64 hash = 0xCBF29CE484222325LL;
-  for(char& c : s) {
+  for(char c : s) {
     hash ^= u64(c);
     hash *= 0x100000001B3LL;
   }
   return hash;
 }
 
-Circom_CalcWit::Circom_CalcWit (Circom_Circuit *aCircuit, uint maxTh) {
+Circom_CalcWit::Circom_CalcWit (Circom_Circuit *aCircuit, uint maxTh) : threadPool(maxTh) {
   circuit = aCircuit;
   inputSignalAssignedCounter = get_main_input_signal_no();
   inputSignalAssigned = new bool[inputSignalAssignedCounter];
@@ -57,10 +59,6 @@ Circom_CalcWit::Circom_CalcWit (Circom_Circuit *aCircuit, uint maxTh) {
   templateInsId2IOSignalInfo = circuit -> templateInsId2IOSignalInfo;
 
   maxThread = maxTh;
-
-  // parallelism
-  numThread = 0;
-
 }
 
 Circom_CalcWit::~Circom_CalcWit() {
@@ -74,29 +72,56 @@ Circom_CalcWit::~Circom_CalcWit() {
 
 }
 
-uint Circom_CalcWit::getInputSignalHashPosition(u64 h) {
+// Returns the context to the state right after construction while keeping
+// its buffers. Every signal other than the constant one is written before it
+// is read during a run, so signalValues does not need to be cleared. The
+// generated code releases all subcomponents but the main one.
+void Circom_CalcWit::reset() {
+  inputSignalAssignedCounter = get_main_input_signal_no();
+  for (uint i = 0; i< inputSignalAssignedCounter; i++) {
+    inputSignalAssigned[i] = false;
+  }
+
+  Circom_Component &main = componentMemory[0];
+  CIRCOM_DELETE_COMPONENT_ARRAY(main.subcomponents);
+  CIRCOM_DELETE_COMPONENT_ARRAY(main.subcomponentsParallel);
+  CIRCOM_DELETE_COMPONENT_ARRAY(main.sbct);
+  main.subcomponents = nullptr;
+  main.subcomponentsParallel = nullptr;
+  main.sbct = nullptr;
+  componentArena.reset();
+}
+
+bool Circom_findInput(const Circom_Circuit *circuit, u64 h, uint &pos) {
   uint n = get_size_of_input_hashmap();
-  uint pos = (uint)(h % (u64)n);
-  if (circuit->InputHashMap[pos].hash!=h){
-    uint inipos = pos;
-    pos++;
-    while (pos != inipos) {
-      if (circuit->InputHashMap[pos].hash==h) return pos;
-      if (circuit->InputHashMap[pos].hash==0) {
-        fprintf(stderr, "Signal not found\n");
-        throw std::runtime_error("Signal not found");
-      }
-      pos = (pos+1)%n; 
-    }
-    fprintf(stderr, "Signals not found\n");
-    throw std::runtime_error("Signals not found");
+  pos = (uint)(h % (u64)n);
+  for (uint i = 0; i < n; i++) {
+    if (circuit->InputHashMap[pos].hash == h) return true;
+    if (circuit->InputHashMap[pos].hash == 0) return false;
+    pos = (pos+1)%n;
+  }
+  return false;
+}
+
+uint Circom_CalcWit::getInputSignalHashPosition(u64 h) {
+  uint pos;
+  if (!Circom_findInput(circuit, h, pos)) {
+    fprintf(stderr, "Signal not found\n");
+    throw std::runtime_error("Signal not found");
   }
   return pos;
 }
 
 void Circom_CalcWit::tryRunCircuit(){ 
   if (inputSignalAssignedCounter == 0) {
-    run(this);
+    try {
+      run(this);
+    } catch (...) {
+      // Parallel subcomponents of the failed run may still be using the
+      // context.
+      threadPool.waitAll();
+      throw;
+    }
   }
 }
 
@@ -125,22 +150,185 @@ void Circom_CalcWit::setInputSignal(u64 h, uint i,  FrElement & val){
   tryRunCircuit();
 }
 
+// Sets the first n elements of input signal h with a single hash lookup.
+void Circom_CalcWit::setInputSignalRange(u64 h, const FrElement *vals, uint n){
+  uint pos = getInputSignalHashPosition(h);
+  if (n > circuit->InputHashMap[pos].signalsize) {
+    fprintf(stderr, "Input signal array access exceeds the size\n");
+    throw std::runtime_error("Input signal array access exceeds the size");
+  }
+  setInputSignalRangeAt(circuit->InputHashMap[pos].signalid, vals, n);
+}
+
+// Sets n consecutive input signals starting at signal id si, as returned by
+// getInputSignalOffset(). Nothing is written unless all of them are still
+// unassigned, and the circuit runs once the last input is set.
+void Circom_CalcWit::setInputSignalRangeAt(u64 si, const FrElement *vals, uint n){
+  if (inputSignalAssignedCounter == 0) {
+    fprintf(stderr, "No more signals to be assigned\n");
+    throw std::runtime_error("No more signals to be assigned");
+  }
+  u64 start = get_main_input_signal_start();
+  if (si < start || si + n > start + get_main_input_signal_no()) {
+    fprintf(stderr, "Input signal index out of range: %llu\n", si);
+    throw std::runtime_error("Input signal index out of range");
+  }
+
+  bool *assigned = &inputSignalAssigned[si-start];
+  for (uint i = 0; i < n; i++) {
+    if (assigned[i]) {
+      fprintf(stderr, "Signal assigned twice: %llu\n", si+i);
+      const size_t errLn = 256;
+      char err[errLn];
+      snprintf(err, errLn, "Signal assigned twice: %llu", si+i);
+      throw std::runtime_error(err);
+    }
+  }
+  std::copy(vals, vals+n, &signalValues[si]);
+  std::fill(assigned, assigned+n, true);
+  inputSignalAssignedCounter -= n;
+  tryRunCircuit();
+}
+
 u64 Circom_CalcWit::getInputSignalSize(u64 h) {
   uint pos = getInputSignalHashPosition(h);
   return circuit->InputHashMap[pos].signalsize;
 }
 
+u64 Circom_CalcWit::getInputSignalOffset(u64 h) {
+  uint pos = getInputSignalHashPosition(h);
+  return circuit->InputHashMap[pos].signalid;
+}
+
+// Normal-form limbs of a non-Montgomery element. Most witnesses are short
+// values, which are expanded here without calling into the field backend.
+static inline void toRawNormal(FrRawElement r, PFrElement v) {
+  if (v->type == Fr_SHORT) {
+    if (v->shortVal >= 0) {
+      r[0] = (u64)v->shortVal;
+      for (int i = 1; i < Fr_N64; i++) r[i] = 0;
+    } else {
+      // q - |v|
+      u64 m = (u64)(-(int64_t)v->shortVal);
+      u64 borrow = Fr_q.longVal[0] < m;
+      r[0] = Fr_q.longVal[0] - m;
+      for (int i = 1; i < Fr_N64; i++) {
+        u64 qi = Fr_q.longVal[i];
+        r[i] = qi - borrow;
+        borrow = qi < borrow;
+      }
+    }
+  } else if (v->type == Fr_LONG) {
+    std::memcpy(r, &v->longVal, sizeof(FrRawElement));
+  } else {
+    FrElement e;
+    Fr_toLongNormal(&e, v);
+    std::memcpy(r, &e.longVal, sizeof(FrRawElement));
+  }
+}
+
+// Montgomery-form limbs of a non-Montgomery element. Zero, the most common
+// witness, needs no multiplication.
+static inline void toRawMontgomery(FrRawElement r, PFrElement v) {
+  if (v->type == Fr_SHORT && v->shortVal == 0) {
+    for (int i = 0; i < Fr_N64; i++) r[i] = 0;
+  } else {
+    FrElement e;
+    Fr_toMontgomery(&e, v);
+    std::memcpy(r, &e.longVal, sizeof(FrRawElement));
+  }
+}
+
+// Montgomery-form values are gathered and converted in bulk, which runs on
+// the vector backend when the CPU has one. With montgomery they are copied
+// as they are and only the other values are converted, the other way.
+void Circom_CalcWit::exportWitnessBlock(uint idx, uint n, FrRawElement *out, bool montgomery) {
+  const u64 *list = &circuit->witness2SignalList[idx];
+  uint k = 0;
+  while (k < n) {
+    PFrElement v = &signalValues[list[k]];
+    if (v->type == Fr_LONGMONTGOMERY) {
+      // Converts the whole run of Montgomery values starting here in place.
+      uint first = k;
+      do {
+        std::memcpy(out[k], &v->longVal, sizeof(FrRawElement));
+        if (++k == n) break;
+        v = &signalValues[list[k]];
+      } while (v->type == Fr_LONGMONTGOMERY);
+      if (!montgomery) {
+        Fr_rawFromMontgomeryN(&out[first], &out[first], k - first);
+      }
+    } else {
+      if (montgomery) {
+        toRawMontgomery(out[k], v);
+      } else {
+        toRawNormal(out[k], v);
+      }
+      k++;
+    }
+  }
+}
+
+const uint Circom_CalcWit::WitnessBlock;
+
+void Circom_CalcWit::exportWitnessChunk(uint idx, uint first, uint last, char *out, bool montgomery) {
+  FrRawElement block[WitnessBlock];
+  for (uint i = first; i < last; i += WitnessBlock) {
+    uint m = std::min(WitnessBlock, last - i);
+    exportWitnessBlock(idx + i, m, block, montgomery);
+    std::memcpy(out + (u64)i*sizeof(FrRawElement), block, m*sizeof(FrRawElement));
+  }
+}
+
+void Circom_CalcWit::getWitnessRange(uint idx, uint n, FrRawElement *out) {
+  exportWitnessChunk(idx, 0, n, (char *)out, false);
+}
+
+// Chunks are whole blocks and at least MinChunk witnesses long, below which
+// starting a thread costs more than it saves.
+void Circom_CalcWit::getWitnessBytes(uint idx, uint n, void *out, bool montgomery, uint nThreads) {
+  const uint MinChunk = 16384;
+  if (nThreads == 0) {
+    nThreads = std::min<uint>(maxThread, std::max(1u, std::thread::hardware_concurrency()));
+  }
+  nThreads = std::max(1u, std::min(nThreads, n / MinChunk));
+
+  uint chunk = (n + nThreads - 1) / nThreads;
+  chunk = (chunk + WitnessBlock - 1) / WitnessBlock * WitnessBlock;
+
+  std::vector<std::thread> threads;
+  uint first = chunk;
+  try {
+    for (; first < n; first += chunk) {
+      threads.emplace_back(&Circom_CalcWit::exportWitnessChunk, this,
+                           idx, first, std::min(n, first + chunk), (char *)out, montgomery);
+    }
+  } catch (...) {
+    // Out of threads: convert the chunks that did not get one here.
+    exportWitnessChunk(idx, first, n, (char *)out, montgomery);
+  }
+  exportWitnessChunk(idx, 0, std::min(n, chunk), (char *)out, montgomery);
+
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+}
+
 std::string Circom_CalcWit::getTrace(u64 id_cmp){
-  if (id_cmp == 0) return componentMemory[id_cmp].componentName;
+  const Circom_ComponentName* entry = get_component_name(componentMemory[id_cmp].componentNameId);
+  std::string my_name = entry->name;
+  if (entry->nDimensions > 0) {
+    my_name += generate_position_array(entry->dimensions, entry->nDimensions, componentMemory[id_cmp].componentPosition);
+  }
+
+  if (id_cmp == 0) return my_name;
   else{
     u64 id_father = componentMemory[id_cmp].idFather;
-    std::string my_name = componentMemory[id_cmp].componentName;
-
     return Circom_CalcWit::getTrace(id_father) + "." + my_name;
   }
 }
 
-std::string Circom_CalcWit::generate_position_array(uint* dimensions, uint size_dimensions, uint index){
+std::string Circom_CalcWit::generate_position_array(const u32* dimensions, uint size_dimensions, uint index){
   std::string positions = "";
 
   for (uint i = 0 ; i < size_dimensions; i++){
@@ -152,4 +340,217 @@ std::string Circom_CalcWit::generate_position_array(uint* dimensions, uint size_
   return positions;
 }
 
+Circom_Arena::Circom_Arena() {
+  current = 0;
+  offset = 0;
+}
+
+Circom_Arena::~Circom_Arena() {
+  reset();
+  for (Chunk &chunk : chunks) {
+    free(chunk.data);
+  }
+}
+
+void *Circom_Arena::alloc(size_t size, size_t align) {
+  std::lock_guard<std::mutex> guard(lock);
+  while (current < chunks.size()) {
+    size_t start = (offset + align - 1) & ~(align - 1);
+    if (start + size <= chunks[current].size) {
+      offset = start + size;
+      return chunks[current].data + start;
+    }
+    current++;
+    offset = 0;
+  }
+  Chunk chunk;
+  chunk.size = size > ChunkSize ? size : ChunkSize;
+  chunk.data = (char*)malloc(chunk.size);
+  if (chunk.data == NULL) {
+    throw std::bad_alloc();
+  }
+  chunks.push_back(chunk);
+  current = chunks.size() - 1;
+  offset = size;
+  return chunk.data;
+}
+
+void Circom_Arena::addFinalizer(void (*destroy)(void *p, uint n), void *p, uint n) {
+  std::lock_guard<std::mutex> guard(lock);
+  finalizers.push_back({destroy, p, n});
+}
+
+void Circom_Arena::reset() {
+  for (Finalizer &f : finalizers) {
+    f.destroy(f.p, f.n);
+  }
+  finalizers.clear();
+  current = 0;
+  offset = 0;
+}
+
+// Queue index of the calling thread in the pool it works for. Any other
+// thread is taken to be the one owning the context.
+static thread_local Circom_ThreadPool *workerPool = nullptr;
+static thread_local uint workerQueue = 0;
+
+Circom_ThreadPool::Circom_ThreadPool(uint maxThreads) {
+  uint hw = std::thread::hardware_concurrency();
+  uint n = maxThreads;
+  if (hw > 0 && hw < n) n = hw;
+  nWorkers = n > 1 ? n - 1 : 0;
+  for (uint i = 0; i <= nWorkers; i++) {
+    queues.emplace_back(new Queue());
+  }
+  queued = 0;
+  unfinished = 0;
+  stopping = false;
+}
+
+Circom_ThreadPool::~Circom_ThreadPool() {
+  {
+    std::lock_guard<std::mutex> guard(sleepMutex);
+    stopping = true;
+  }
+  sleepCv.notify_all();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+uint Circom_ThreadPool::currentQueue() {
+  return workerPool == this ? workerQueue : nWorkers;
+}
+
+void Circom_ThreadPool::submit(Circom_TemplateFunction run, uint index, Circom_CalcWit *ctx, Circom_Future *future) {
+  Task task = {run, index, ctx, future};
+  future->error = nullptr;
+  future->pending.store(true, std::memory_order_relaxed);
+  unfinished++;
+  if (nWorkers == 0) {
+    execute(task);
+    return;
+  }
+  if (workers.empty()) {
+    for (uint i = 0; i < nWorkers; i++) {
+      workers.emplace_back(&Circom_ThreadPool::workerLoop, this, i);
+    }
+  }
+
+  Queue &queue = *queues[currentQueue()];
+  queued++;
+  {
+    std::lock_guard<std::mutex> guard(queue.lock);
+    queue.tasks.push_back(task);
+  }
+  {
+    std::lock_guard<std::mutex> guard(sleepMutex);
+  }
+  sleepCv.notify_one();
+}
+
+// Takes the newest task of the thread's own queue, or else steals the oldest
+// one of another queue.
+bool Circom_ThreadPool::pop(uint self, Task &task) {
+  if (queued.load() <= 0) return false;
+  for (uint i = 0; i <= nWorkers; i++) {
+    Queue &queue = *queues[(self + i) % (nWorkers + 1)];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.tasks.empty()) continue;
+    if (i == 0) {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+    } else {
+      task = queue.tasks.front();
+      queue.tasks.pop_front();
+    }
+    queued--;
+    return true;
+  }
+  return false;
+}
+
+void Circom_ThreadPool::execute(Task &task) {
+  try {
+    task.run(task.index, task.ctx);
+  } catch (...) {
+    task.future->error = std::current_exception();
+  }
+  task.future->pending.store(false, std::memory_order_release);
+  unfinished--;
+}
+
+void Circom_ThreadPool::workerLoop(uint self) {
+  workerPool = this;
+  workerQueue = self;
+  for (;;) {
+    Task task;
+    if (pop(self, task)) {
+      execute(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> guard(sleepMutex);
+    sleepCv.wait(guard, [this]() { return stopping || queued.load() > 0; });
+    if (stopping) return;
+  }
+}
+
+void Circom_ThreadPool::wait(Circom_Future &future) {
+  uint self = currentQueue();
+  while (future.pending.load(std::memory_order_acquire)) {
+    Task task;
+    if (pop(self, task)) {
+      execute(task);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  if (future.error) {
+    std::exception_ptr error = future.error;
+    future.error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void Circom_ThreadPool::waitAll() {
+  uint self = currentQueue();
+  while (unfinished.load() > 0) {
+    Task task;
+    if (pop(self, task)) {
+      execute(task);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+Circom_CalcWitPool::Circom_CalcWitPool(Circom_Circuit *aCircuit, uint maxTh) {
+  circuit = aCircuit;
+  maxThread = maxTh;
+}
+
+Circom_CalcWitPool::~Circom_CalcWitPool() {
+  for (Circom_CalcWit* ctx : idle) {
+    delete ctx;
+  }
+}
+
+Circom_CalcWit* Circom_CalcWitPool::acquire() {
+  {
+    std::lock_guard<std::mutex> lock(idleMutex);
+    if (!idle.empty()) {
+      Circom_CalcWit* ctx = idle.back();
+      idle.pop_back();
+      return ctx;
+    }
+  }
+  return new Circom_CalcWit(circuit, maxThread);
+}
+
+void Circom_CalcWitPool::release(Circom_CalcWit* ctx) {
+  ctx->reset();
+  std::lock_guard<std::mutex> lock(idleMutex);
+  idle.push_back(ctx);
+}
+
 } //namespace
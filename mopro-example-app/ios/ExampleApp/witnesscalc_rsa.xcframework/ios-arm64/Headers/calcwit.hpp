@@ -3,22 +3,152 @@
 
 #include <mutex>
 #include <condition_variable>
+#include <deque>
+#include <thread>
 #include <functional>
 #include <atomic>
 #include <memory>
+#include <vector>
+#include <new>
+#include <type_traits>
+#include <cstring>
 
 #include "circom.hpp"
 #include "fr.hpp"
+#include "fr_vec.hpp"
+#include "fr_inline.hpp"
 
 #define NMUTEXES 12 //512
 
 namespace CIRCUIT_NAME {
 
-u64 fnv1a(std::string s);
+u64 fnv1a(const std::string &s);
+
+// Position in the input hash map of circuit of the input whose name hashes
+// to h. Lets callers resolve a name once and use its signal id afterwards.
+bool Circom_findInput(const Circom_Circuit *circuit, u64 h, uint &pos);
+
+// Bump allocator for the per-component metadata created during a run.
+// Nothing is freed individually: reset() rewinds it in O(1) (plus running
+// the destructors of non-trivial arrays, which only parallel components
+// have) and keeps the chunks for the next run.
+class Circom_Arena {
+
+  struct Chunk {
+    char *data;
+    size_t size;
+  };
+
+  struct Finalizer {
+    void (*destroy)(void *p, uint n);
+    void *p;
+    uint n;
+  };
+
+  static const size_t ChunkSize = 64*1024;
+
+  std::mutex lock; // parallel subcomponents create from pool threads
+  std::vector<Chunk> chunks;
+  size_t current;
+  size_t offset;
+  std::vector<Finalizer> finalizers;
+
+  void addFinalizer(void (*destroy)(void *p, uint n), void *p, uint n);
+
+  template<typename T>
+  static void destroyArray(void *p, uint n) {
+    for (uint i = 0; i < n; i++) ((T*)p)[i].~T();
+  }
+
+public:
+
+  Circom_Arena();
+  ~Circom_Arena();
+
+  void *alloc(size_t size, size_t align);
+  void reset();
+
+  // Value-initialized array of n elements, like new T[n]().
+  template<typename T>
+  T *newArray(uint n) {
+    T *p = (T*)alloc(n*sizeof(T), alignof(T));
+    for (uint i = 0; i < n; i++) new (&p[i]) T();
+    if (!std::is_trivially_destructible<T>::value && n > 0) {
+      addFinalizer(&destroyArray<T>, p, n);
+    }
+    return p;
+  }
+};
+
+// Generated *_create functions allocate the component arrays through these,
+// so building the runtime with CIRCOM_COMPONENT_ARENA moves them from the
+// heap into the context's componentArena.
+#ifdef CIRCOM_COMPONENT_ARENA
+#define CIRCOM_NEW_COMPONENT_ARRAY(ctx, T, n) ((ctx)->componentArena.newArray<T>(n))
+#define CIRCOM_DELETE_COMPONENT_ARRAY(p)
+#else
+#define CIRCOM_NEW_COMPONENT_ARRAY(ctx, T, n) (new T[n]())
+#define CIRCOM_DELETE_COMPONENT_ARRAY(p) delete[] (p)
+#endif
 
 void check(bool condition);
 void checkWithMsg(bool condition, const char* failMsg);
 
+class Circom_CalcWit;
+
+typedef void (*Circom_TemplateFunction)(uint __cIdx, Circom_CalcWit* __ctx); 
+
+// Fixed pool of threads that runs the parallel subcomponents of one context.
+// Every thread has its own task deque: it pushes and pops at the back and,
+// once it runs dry, steals from the front of the others. A thread waiting on
+// a future keeps running queued tasks meanwhile, so nested parallel
+// components cannot starve the pool. Workers start on the first submit(), and
+// with maxThreads <= 1 tasks simply run inline.
+class Circom_ThreadPool {
+
+  struct Task {
+    Circom_TemplateFunction run;
+    uint index;
+    Circom_CalcWit *ctx;
+    Circom_Future *future;
+  };
+
+  struct Queue {
+    std::mutex lock;
+    std::deque<Task> tasks;
+  };
+
+  uint nWorkers;
+  // One queue per worker plus a last one for the thread that owns the context.
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> workers;
+  std::atomic<int> queued;
+  std::atomic<int> unfinished;
+
+  std::mutex sleepMutex;
+  std::condition_variable sleepCv;
+  bool stopping;
+
+  uint currentQueue();
+  bool pop(uint self, Task &task);
+  void execute(Task &task);
+  void workerLoop(uint self);
+
+public:
+
+  Circom_ThreadPool(uint maxThreads);
+  ~Circom_ThreadPool();
+
+  // Runs run(index, ctx) on the pool and completes future when it returns.
+  void submit(Circom_TemplateFunction run, uint index, Circom_CalcWit *ctx, Circom_Future *future);
+
+  // Returns once future is done, rethrowing the exception of its task.
+  void wait(Circom_Future &future);
+
+  // Returns once every submitted task has finished, whatever its outcome.
+  void waitAll();
+};
+
 class Circom_CalcWit {
 
   bool *inputSignalAssigned;
@@ -33,23 +163,26 @@ public:
   FrElement* circuitConstants; 
   std::map<u32,IODefPair> templateInsId2IOSignalInfo; 
   std::string* listOfTemplateMessages; 
+  Circom_Arena componentArena;
 
   // parallelism
-  std::mutex numThreadMutex;
-  std::condition_variable ntcvs;
-  uint numThread;
-
   uint maxThread;
+  Circom_ThreadPool threadPool;
 
   // Functions called by the circuit
   Circom_CalcWit(Circom_Circuit *aCircuit, uint numTh = NMUTEXES);
   ~Circom_CalcWit();
 
   // Public functions
+  void reset();
   void setInputSignal(u64 h, uint i, FrElement &val);
+  void setInputSignalRange(u64 h, const FrElement *vals, uint n);
+  void setInputSignalRangeAt(u64 signalOffset, const FrElement *vals, uint n);
   void tryRunCircuit();
   
   u64 getInputSignalSize(u64 h);
+  // Signal id of the first element of input h, for setInputSignalRangeAt().
+  u64 getInputSignalOffset(u64 h);
 
   inline uint getRemaingInputsToBeSet() {
     return inputSignalAssignedCounter;
@@ -59,17 +192,51 @@ public:
     Fr_copy(val, &signalValues[circuit->witness2SignalList[idx]]);
   }
 
+  // Normal-form limbs of witnesses idx..idx+n-1, as stored in .wtns files.
+  void getWitnessRange(uint idx, uint n, FrRawElement *out);
+
+  // Same as getWitnessRange() but out needs no alignment, so a .wtns image
+  // can be written in place, and the range is split in chunks converted on
+  // nThreads threads (0 means maxThread, up to the number of cores). With
+  // montgomery the limbs are in Montgomery form, as provers use them.
+  void getWitnessBytes(uint idx, uint n, void *out, bool montgomery = false, uint nThreads = 0);
+
   std::string getTrace(u64 id_cmp);
 
-  std::string generate_position_array(uint* dimensions, uint size_dimensions, uint index);
+  std::string generate_position_array(const u32* dimensions, uint size_dimensions, uint index);
 
 private:
   
   uint getInputSignalHashPosition(u64 h);
 
+  static const uint WitnessBlock = 256;
+  void exportWitnessBlock(uint idx, uint n, FrRawElement *out, bool montgomery);
+  void exportWitnessChunk(uint idx, uint first, uint last, char *out, bool montgomery);
+
 };
 
-typedef void (*Circom_TemplateFunction)(uint __cIdx, Circom_CalcWit* __ctx); 
+// Keeps reset contexts of one circuit around so back-to-back witness
+// computations reuse their buffers instead of reallocating them.
+class Circom_CalcWitPool {
+
+  Circom_Circuit *circuit;
+  uint maxThread;
+
+  std::mutex idleMutex;
+  std::vector<Circom_CalcWit*> idle;
+
+public:
+
+  Circom_CalcWitPool(Circom_Circuit *aCircuit, uint numTh = NMUTEXES);
+  ~Circom_CalcWitPool();
+
+  // Returns an idle context, or a new one if all of them are in use.
+  Circom_CalcWit* acquire();
+
+  // Resets ctx and keeps it for the next acquire(). Contexts whose run
+  // failed half way must be deleted instead.
+  void release(Circom_CalcWit* ctx);
+};
 
 } //namespace
 
@@ -2,10 +2,9 @@
 #define __CIRCOM_H
 
 #include <map>
-#include <gmp.h>
+#include <atomic>
+#include <exception>
 #include <mutex>
-#include <condition_variable>
-#include <thread>
 
 #include "fr.hpp"
 
@@ -40,13 +39,20 @@ struct Circom_Circuit {
   FrElement* circuitConstants = nullptr;  
   std::map<u32,IODefPair> templateInsId2IOSignalInfo;
 
+  // The arrays above point into the caller's .dat buffer (usually a
+  // read-only shared mapping) instead of owned copies.
+  bool zeroCopy = false;
+
   ~Circom_Circuit() {
 
-    delete[] InputHashMap;
+    if (!zeroCopy) {
+
+      delete[] InputHashMap;
 
-    delete[] witness2SignalList;
+      delete[] witness2SignalList;
 
-    delete[] circuitConstants;
+      delete[] circuitConstants;
+    }
 
     for (auto &pair : templateInsId2IOSignalInfo) {
       auto *defs = pair.second.defs;
@@ -60,22 +66,36 @@ struct Circom_Circuit {
 };
 
 
+// Completion of a task run by the context's thread pool. Consumers wait on
+// it through Circom_ThreadPool::wait(), which also rethrows the task's
+// exception. A future that was never submitted counts as done.
+struct Circom_Future {
+  std::atomic<bool> pending;
+  std::exception_ptr error;
+};
+
+// Static component name emitted with the generated circuit. Components only
+// keep the id of their entry plus their position, and traces are built
+// from the table when an assert fails.
+struct Circom_ComponentName {
+  const char* name;
+  u32 nDimensions;
+  const u32* dimensions;
+};
+
 struct Circom_Component {
   u32 templateId;
   u64 signalStart;
   u32 inputCounter;
-  std::string templateName;
-  std::string componentName;
+  u32 componentNameId;   // entry in the circuit's component name table
+  u32 componentPosition; // flat index when the component is an array
   u64 idFather; 
   u32* subcomponents = nullptr;
   bool* subcomponentsParallel = nullptr;
-  bool *outputIsSet = nullptr;  //one for each output
-  std::mutex *mutexes = nullptr;  //one for each output
-  std::condition_variable *cvs = nullptr;
-  std::thread *sbct = nullptr; //subcomponent threads
+  Circom_Future *sbct = nullptr; //subcomponent runs submitted to the thread pool
 
   Circom_Component()
-	: subcomponents(0), subcomponentsParallel(0), outputIsSet(0), mutexes(0), cvs(0), sbct(0)
+	: subcomponents(0), subcomponentsParallel(0), sbct(0)
   {}
 
 };
@@ -106,6 +126,8 @@ uint get_size_of_input_hashmap();
 uint get_size_of_witness();
 uint get_size_of_constants();
 uint get_size_of_io_map();
+const char* get_template_name(uint templateId);
+const Circom_ComponentName* get_component_name(uint nameId);
 
 } //namespace
 #endif  // __CIRCOM_H
@@ -5,7 +5,11 @@
 #include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
 #include <string>
+#include <system_error>
 #include <iostream>
 
 class FileMapLoader
@@ -28,8 +32,12 @@ public:
         }
 
         size =  sb.st_size;
-        buffer = (char*)mmap(NULL, size, PROT_READ , MAP_PRIVATE, fd, 0);
+        buffer = (char*)mmap(NULL, size, PROT_READ , MAP_SHARED, fd, 0);
         close(fd);
+
+        if (buffer == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap");
+        }
     }
 
     ~FileMapLoader()
@@ -44,4 +52,122 @@ public:
     size_t  size;
 };
 
+// Output file of a known size that is filled in place through a shared
+// mapping. Its blocks are allocated before it is mapped, since a store to a
+// page the file system then fails to allocate, on a full disk, raises
+// SIGBUS instead of returning an error. Where the file cannot be allocated
+// or mapped, e.g. a pipe, the data goes to a heap buffer instead, which
+// commit() writes with as few write() calls as the kernel allows. Nothing is
+// guaranteed to be in the file before commit(); discard() removes a file
+// that will not be completed, if the name was that of a regular file and
+// not, say, /dev/stdout.
+class FileMapWriter
+{
+public:
+    FileMapWriter(const std::string &aFileName, size_t aSize)
+        : buffer(NULL), size(aSize), fileName(aFileName), fd(-1), mapped(false), removable(false)
+    {
+        struct stat sb, lsb;
+
+        fd = open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1) {
+            std::string msg("Could not open ");
+            msg += fileName + " for write";
+            throw std::system_error(errno, std::generic_category(), msg);
+        }
+        bool regular = fstat(fd, &sb) == 0 && S_ISREG(sb.st_mode);
+        removable = regular && lstat(fileName.c_str(), &lsb) == 0 &&
+                    lsb.st_dev == sb.st_dev && lsb.st_ino == sb.st_ino;
+
+        if (regular && size > 0) {
+            if (allocate(fd, size)) {
+                void *p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (p != MAP_FAILED) {
+                    buffer = (char*)p;
+                    mapped = true;
+                    return;
+                }
+            }
+            // Whatever was allocated goes; write() extends the file again.
+            if (ftruncate(fd, 0) == -1) {
+                close(fd);
+                throw std::system_error(errno, std::generic_category(), "ftruncate");
+            }
+        }
+
+        buffer = (char*)malloc(size > 0 ? size : 1);
+        if (buffer == NULL) {
+            close(fd);
+            throw std::bad_alloc();
+        }
+    }
+
+    void commit()
+    {
+        if (mapped) {
+            munmap(buffer, size);
+            mapped = false;
+        } else {
+            for (size_t done = 0; done < size; ) {
+                ssize_t n = write(fd, buffer + done, size - done);
+                if (n == -1) {
+                    if (errno == EINTR) continue;
+                    throw std::system_error(errno, std::generic_category(), "write");
+                }
+                done += n;
+            }
+            free(buffer);
+        }
+        buffer = NULL;
+
+        int error = close(fd);
+        fd = -1;
+        if (error == -1) {
+            throw std::system_error(errno, std::generic_category(), "close");
+        }
+    }
+
+    void discard()
+    {
+        if (removable) {
+            unlink(fileName.c_str());
+        }
+    }
+
+    ~FileMapWriter()
+    {
+        if (mapped) {
+            munmap(buffer, size);
+        } else {
+            free(buffer);
+        }
+        if (fd != -1) {
+            close(fd);
+        }
+    }
+
+    FileMapWriter(const FileMapWriter&) = delete;
+    FileMapWriter& operator=(const FileMapWriter&) = delete;
+
+    char   *buffer;
+    size_t  size;
+
+private:
+    // Allocates the first size bytes of fd, which also become its length.
+    static bool allocate(int fd, size_t size)
+    {
+#ifdef __APPLE__
+        fstore_t store = {F_ALLOCATEALL, F_PEOFPOSMODE, 0, (off_t)size, 0};
+        return fcntl(fd, F_PREALLOCATE, &store) != -1 && ftruncate(fd, size) == 0;
+#else
+        return posix_fallocate(fd, 0, size) == 0;
+#endif
+    }
+
+    std::string fileName;
+    int     fd;
+    bool    mapped;
+    bool    removable;
+};
+
 #endif //WITNESSCALC_INTERNAL_H
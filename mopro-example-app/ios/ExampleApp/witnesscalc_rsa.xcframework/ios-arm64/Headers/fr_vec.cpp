@@ -0,0 +1,257 @@
+#include "fr_vec.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define FR_VEC_IFMA
+#include <immintrin.h>
+#endif
+
+
+static void rawMMulNScalar(FrRawElement *r, const FrRawElement *a, const FrRawElement *b, uint n) {
+    for (uint i=0; i<n; i++) Fr_rawMMul(r[i], a[i], b[i]);
+}
+
+static void rawAddNScalar(FrRawElement *r, const FrRawElement *a, const FrRawElement *b, uint n) {
+    for (uint i=0; i<n; i++) Fr_rawAdd(r[i], a[i], b[i]);
+}
+
+static void rawFromMontgomeryNScalar(FrRawElement *r, const FrRawElement *a, uint n) {
+    for (uint i=0; i<n; i++) Fr_rawFromMontgomery(r[i], a[i]);
+}
+
+
+#ifdef FR_VEC_IFMA
+
+// Eight elements are held in five registers of 52-bit limbs, register j
+// holding limb j of every lane. vpmadd52luq/huq add the low/high 52 bits of
+// the 104-bit limb products to 64-bit accumulators, so carries only need
+// propagating once per product. Limb 4 keeps the top 48 bits of the
+// 256-bit value.
+
+#define FR_VEC_TARGET __attribute__((target("avx512f,avx512ifma"), always_inline)) inline
+
+static const uint64_t M52 = (1ULL << 52) - 1;
+static const uint64_t M48 = (1ULL << 48) - 1;
+
+struct FrVecConsts {
+    uint64_t q[5];  // modulus in 52-bit limbs
+    uint64_t k0;    // -q^-1 mod 2^52
+};
+
+static FrVecConsts makeVecConsts() {
+    FrVecConsts c;
+    c.q[0] = Fr_rawq[0] & M52;
+    c.q[1] = (Fr_rawq[0] >> 52 | Fr_rawq[1] << 12) & M52;
+    c.q[2] = (Fr_rawq[1] >> 40 | Fr_rawq[2] << 24) & M52;
+    c.q[3] = (Fr_rawq[2] >> 28 | Fr_rawq[3] << 36) & M52;
+    c.q[4] = Fr_rawq[3] >> 16;
+    uint64_t inv = Fr_rawq[0];
+    for (int i = 0; i < 5; i++) inv *= 2 - Fr_rawq[0]*inv;
+    c.k0 = (0 - inv) & M52;
+    return c;
+}
+
+static const FrVecConsts vecConsts = makeVecConsts();
+
+// Lanes of the block starting at element 2*j that are present, as a mask
+// over the eight 64-bit words of one 512-bit load or store.
+FR_VEC_TARGET static __mmask8 pairMask(uint n, uint j) {
+    if (n >= 2*j + 2) return 0xFF;
+    if (n == 2*j + 1) return 0x0F;
+    return 0;
+}
+
+FR_VEC_TARGET static void load52(__m512i x[5], const FrRawElement *a, uint n) {
+    const uint64_t *p = a[0];
+    __m512i v0 = _mm512_maskz_loadu_epi64(pairMask(n, 0), p);
+    __m512i v1 = _mm512_maskz_loadu_epi64(pairMask(n, 1), p + 8);
+    __m512i v2 = _mm512_maskz_loadu_epi64(pairMask(n, 2), p + 16);
+    __m512i v3 = _mm512_maskz_loadu_epi64(pairMask(n, 3), p + 24);
+
+    // Transpose element-major words into word-major registers.
+    const __m512i lo = _mm512_setr_epi64(0, 4, 8, 12, 1, 5, 9, 13);
+    const __m512i hi = _mm512_setr_epi64(2, 6, 10, 14, 3, 7, 11, 15);
+    const __m512i first = _mm512_setr_epi64(0, 1, 2, 3, 8, 9, 10, 11);
+    const __m512i second = _mm512_setr_epi64(4, 5, 6, 7, 12, 13, 14, 15);
+    __m512i t0 = _mm512_permutex2var_epi64(v0, lo, v1);
+    __m512i t1 = _mm512_permutex2var_epi64(v2, lo, v3);
+    __m512i t2 = _mm512_permutex2var_epi64(v0, hi, v1);
+    __m512i t3 = _mm512_permutex2var_epi64(v2, hi, v3);
+    __m512i w0 = _mm512_permutex2var_epi64(t0, first, t1);
+    __m512i w1 = _mm512_permutex2var_epi64(t0, second, t1);
+    __m512i w2 = _mm512_permutex2var_epi64(t2, first, t3);
+    __m512i w3 = _mm512_permutex2var_epi64(t2, second, t3);
+
+    const __m512i m = _mm512_set1_epi64(M52);
+    x[0] = _mm512_and_si512(w0, m);
+    x[1] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(w0, 52), _mm512_slli_epi64(w1, 12)), m);
+    x[2] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(w1, 40), _mm512_slli_epi64(w2, 24)), m);
+    x[3] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(w2, 28), _mm512_slli_epi64(w3, 36)), m);
+    x[4] = _mm512_srli_epi64(w3, 16);
+}
+
+FR_VEC_TARGET static void store52(FrRawElement *r, const __m512i x[5], uint n) {
+    __m512i w0 = _mm512_or_si512(x[0], _mm512_slli_epi64(x[1], 52));
+    __m512i w1 = _mm512_or_si512(_mm512_srli_epi64(x[1], 12), _mm512_slli_epi64(x[2], 40));
+    __m512i w2 = _mm512_or_si512(_mm512_srli_epi64(x[2], 24), _mm512_slli_epi64(x[3], 28));
+    __m512i w3 = _mm512_or_si512(_mm512_srli_epi64(x[3], 36), _mm512_slli_epi64(x[4], 16));
+
+    const __m512i lo = _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11);
+    const __m512i hi = _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15);
+    const __m512i first = _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11);
+    const __m512i second = _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15);
+    __m512i a01lo = _mm512_permutex2var_epi64(w0, lo, w1);
+    __m512i a01hi = _mm512_permutex2var_epi64(w0, hi, w1);
+    __m512i a23lo = _mm512_permutex2var_epi64(w2, lo, w3);
+    __m512i a23hi = _mm512_permutex2var_epi64(w2, hi, w3);
+
+    uint64_t *p = r[0];
+    _mm512_mask_storeu_epi64(p, pairMask(n, 0), _mm512_permutex2var_epi64(a01lo, first, a23lo));
+    _mm512_mask_storeu_epi64(p + 8, pairMask(n, 1), _mm512_permutex2var_epi64(a01lo, second, a23lo));
+    _mm512_mask_storeu_epi64(p + 16, pairMask(n, 2), _mm512_permutex2var_epi64(a01hi, first, a23hi));
+    _mm512_mask_storeu_epi64(p + 24, pairMask(n, 3), _mm512_permutex2var_epi64(a01hi, second, a23hi));
+}
+
+// x = x - q if that does not go negative. Expects normalized limbs.
+FR_VEC_TARGET static void reduceOnce(__m512i x[5], const __m512i q[5]) {
+    const __m512i m = _mm512_set1_epi64(M52);
+    __m512i d[5];
+    __m512i carry = _mm512_setzero_si512();
+    for (int j = 0; j < 5; j++) {
+        __m512i t = _mm512_add_epi64(_mm512_sub_epi64(x[j], q[j]), carry);
+        carry = _mm512_srai_epi64(t, 52);
+        d[j] = _mm512_and_si512(t, m);
+    }
+    __mmask8 noBorrow = _mm512_cmpge_epi64_mask(carry, _mm512_setzero_si512());
+    for (int j = 0; j < 5; j++) x[j] = _mm512_mask_blend_epi64(noBorrow, x[j], d[j]);
+}
+
+// Montgomery product r = a*b/2^256 mod q. Four interleaved reduction rounds
+// of 52 bits and a last one of 48 bits divide by exactly 2^256, so the
+// results stay in the same Montgomery domain as the scalar routines.
+FR_VEC_TARGET static void mmul52(__m512i r[5], const __m512i a[5], const __m512i b[5]) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i m52 = _mm512_set1_epi64(M52);
+    const __m512i k0 = _mm512_set1_epi64(vecConsts.k0);
+    __m512i q[5];
+    for (int j = 0; j < 5; j++) q[j] = _mm512_set1_epi64(vecConsts.q[j]);
+
+    __m512i t[6];
+    for (int j = 0; j < 6; j++) t[j] = zero;
+
+    for (int i = 0; i < 5; i++) {
+        for (int j = 0; j < 5; j++) {
+            t[j] = _mm512_madd52lo_epu64(t[j], a[j], b[i]);
+            t[j+1] = _mm512_madd52hi_epu64(t[j+1], a[j], b[i]);
+        }
+        __m512i m = _mm512_madd52lo_epu64(zero, t[0], k0);
+        if (i == 4) m = _mm512_and_si512(m, _mm512_set1_epi64(M48));
+        for (int j = 0; j < 5; j++) {
+            t[j] = _mm512_madd52lo_epu64(t[j], m, q[j]);
+            t[j+1] = _mm512_madd52hi_epu64(t[j+1], m, q[j]);
+        }
+        if (i == 4) break;
+        // The low 52 bits of t[0] are now zero: shift down one limb.
+        t[1] = _mm512_add_epi64(t[1], _mm512_srli_epi64(t[0], 52));
+        for (int j = 0; j < 5; j++) t[j] = t[j+1];
+        t[5] = zero;
+    }
+
+    // Normalize, then drop the 48 low bits cleared by the last round.
+    for (int j = 0; j < 5; j++) {
+        t[j+1] = _mm512_add_epi64(t[j+1], _mm512_srli_epi64(t[j], 52));
+        t[j] = _mm512_and_si512(t[j], m52);
+    }
+    for (int j = 0; j < 5; j++) {
+        r[j] = _mm512_or_si512(_mm512_srli_epi64(t[j], 48),
+                               _mm512_and_si512(_mm512_slli_epi64(t[j+1], 4), m52));
+    }
+    reduceOnce(r, q);
+}
+
+__attribute__((target("avx512f,avx512ifma")))
+static void rawMMulNIfma(FrRawElement *r, const FrRawElement *a, const FrRawElement *b, uint n) {
+    for (uint i = 0; i < n; i += 8) {
+        uint k = n - i < 8 ? n - i : 8;
+        __m512i x[5], y[5], z[5];
+        load52(x, a + i, k);
+        load52(y, b + i, k);
+        mmul52(z, x, y);
+        store52(r + i, z, k);
+    }
+}
+
+__attribute__((target("avx512f,avx512ifma")))
+static void rawAddNIfma(FrRawElement *r, const FrRawElement *a, const FrRawElement *b, uint n) {
+    const __m512i m52 = _mm512_set1_epi64(M52);
+    __m512i q[5];
+    for (int j = 0; j < 5; j++) q[j] = _mm512_set1_epi64(vecConsts.q[j]);
+    for (uint i = 0; i < n; i += 8) {
+        uint k = n - i < 8 ? n - i : 8;
+        __m512i x[5], y[5];
+        load52(x, a + i, k);
+        load52(y, b + i, k);
+        for (int j = 0; j < 5; j++) x[j] = _mm512_add_epi64(x[j], y[j]);
+        for (int j = 0; j < 4; j++) {
+            x[j+1] = _mm512_add_epi64(x[j+1], _mm512_srli_epi64(x[j], 52));
+            x[j] = _mm512_and_si512(x[j], m52);
+        }
+        reduceOnce(x, q);
+        store52(r + i, x, k);
+    }
+}
+
+__attribute__((target("avx512f,avx512ifma")))
+static void rawFromMontgomeryNIfma(FrRawElement *r, const FrRawElement *a, uint n) {
+    __m512i one[5];
+    one[0] = _mm512_set1_epi64(1);
+    for (int j = 1; j < 5; j++) one[j] = _mm512_setzero_si512();
+    for (uint i = 0; i < n; i += 8) {
+        uint k = n - i < 8 ? n - i : 8;
+        __m512i x[5], z[5];
+        load52(x, a + i, k);
+        mmul52(z, x, one);
+        store52(r + i, z, k);
+    }
+}
+
+static bool hasIfma() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma");
+}
+
+#endif // FR_VEC_IFMA
+
+
+struct FrVecBackend {
+    void (*mmulN)(FrRawElement *r, const FrRawElement *a, const FrRawElement *b, uint n);
+    void (*addN)(FrRawElement *r, const FrRawElement *a, const FrRawElement *b, uint n);
+    void (*fromMontgomeryN)(FrRawElement *r, const FrRawElement *a, uint n);
+};
+
+static FrVecBackend selectBackend() {
+#ifdef FR_VEC_IFMA
+    if (hasIfma()) {
+        FrVecBackend b = {rawMMulNIfma, rawAddNIfma, rawFromMontgomeryNIfma};
+        return b;
+    }
+#endif
+    FrVecBackend b = {rawMMulNScalar, rawAddNScalar, rawFromMontgomeryNScalar};
+    return b;
+}
+
+static const FrVecBackend &backend() {
+    static const FrVecBackend b = selectBackend();
+    return b;
+}
+
+void Fr_rawMMulN(FrRawElement *r, const FrRawElement *a, const FrRawElement *b, uint n) {
+    backend().mmulN(r, a, b, n);
+}
+
+void Fr_rawAddN(FrRawElement *r, const FrRawElement *a, const FrRawElement *b, uint n) {
+    backend().addN(r, a, b, n);
+}
+
+void Fr_rawFromMontgomeryN(FrRawElement *r, const FrRawElement *a, uint n) {
+    backend().fromMontgomeryN(r, a, n);
+}
@@ -0,0 +1,16 @@
+#ifndef __FR_VEC_H
+#define __FR_VEC_H
+
+#include "fr.hpp"
+
+// Element-wise kernels over arrays of raw elements in Montgomery form. On
+// x86-64 CPUs with AVX-512 IFMA they process eight elements at a time;
+// elsewhere they loop over the scalar Fr_raw* routines. The backend is
+// picked from CPUID on the first call, so one binary runs on any host.
+// r may alias a or b.
+
+void Fr_rawMMulN(FrRawElement *r, const FrRawElement *a, const FrRawElement *b, uint n);
+void Fr_rawAddN(FrRawElement *r, const FrRawElement *a, const FrRawElement *b, uint n);
+void Fr_rawFromMontgomeryN(FrRawElement *r, const FrRawElement *a, uint n);
+
+#endif // __FR_VEC_H
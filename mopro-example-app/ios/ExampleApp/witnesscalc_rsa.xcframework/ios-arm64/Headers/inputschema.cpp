@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#include "inputschema.hpp"
+#include "bininput.hpp"
+
+namespace CIRCUIT_NAME {
+
+namespace {
+
+const char *SchemaMagic = "# witnesscalc input schema";
+const unsigned SchemaVersion = 1;
+
+void schemaError(unsigned line, const std::string &msg) {
+  std::ostringstream stream;
+  stream << "Input schema line " << line << ": " << msg;
+  throw std::runtime_error(stream.str());
+}
+
+bool byIndex(const InputSchemaEntry &a, const InputSchemaEntry &b) {
+  return a.index < b.index;
+}
+
+// Checks entry against the input hash map of circuit. Returns what does
+// not match, or an empty string.
+std::string checkEntry(const Circom_Circuit *circuit, const InputSchemaEntry &entry) {
+  uint pos;
+  if (!Circom_findInput(circuit, fnv1a(entry.name), pos)) {
+    return "no input " + entry.name + " in the circuit";
+  }
+  const HashSignalInfo &info = circuit->InputHashMap[pos];
+  if (info.signalid - get_main_input_signal_start() != entry.index || info.signalsize != entry.size) {
+    return "input " + entry.name + " does not match the circuit";
+  }
+  u64 n = 1;
+  for (u64 d : entry.dims) n *= d;
+  if (n != entry.size) {
+    return "dimensions of " + entry.name + " do not match its size";
+  }
+  return "";
+}
+
+// Sorts entries by index. Every input signal must belong to exactly one.
+std::string checkCoverage(std::vector<InputSchemaEntry> &entries) {
+  std::sort(entries.begin(), entries.end(), byIndex);
+  u64 next = 0;
+  for (const InputSchemaEntry &entry : entries) {
+    if (entry.index != next) return "inputs overlap or are missing";
+    next += entry.size;
+  }
+  if (next != get_main_input_signal_no()) return "inputs are missing";
+  return "";
+}
+
+} // namespace
+
+std::string formatInputSchema(const Circom_Circuit *circuit, const std::vector<JsonInputShape> &shapes) {
+  std::vector<InputSchemaEntry> entries;
+  u64 start = get_main_input_signal_start();
+  for (const JsonInputShape &shape : shapes) {
+    InputSchemaEntry entry;
+    entry.name = shape.name;
+    entry.index = shape.signalOffset - start;
+    entry.size = shape.size;
+    entry.dims = shape.dims;
+    std::string error = checkEntry(circuit, entry);
+    if (!error.empty()) throw std::runtime_error("Input schema: " + error);
+    entries.push_back(entry);
+  }
+  std::string error = checkCoverage(entries);
+  if (!error.empty()) throw std::runtime_error("Input schema: " + error);
+
+  std::ostringstream stream;
+  stream << SchemaMagic << " " << SchemaVersion << " "
+         << std::hex << std::setfill('0') << std::setw(16) << binInputFingerprint(circuit)
+         << std::dec << " " << get_main_input_signal_no() << "\n";
+  for (const InputSchemaEntry &entry : entries) {
+    stream << entry.name << " " << entry.index << " " << entry.size;
+    for (u64 d : entry.dims) stream << " " << d;
+    stream << "\n";
+  }
+  return stream.str();
+}
+
+std::vector<InputSchemaEntry> loadInputSchema(const Circom_Circuit *circuit, const char *schema, unsigned long size) {
+  std::istringstream in(std::string(schema, size));
+  std::string text;
+  unsigned line = 1;
+
+  if (!std::getline(in, text) || text.compare(0, strlen(SchemaMagic), SchemaMagic) != 0) {
+    schemaError(line, "not an input schema");
+  }
+  std::istringstream header(text.substr(strlen(SchemaMagic)));
+  unsigned version;
+  u64 fingerprint, n;
+  if (!(header >> version >> std::hex >> fingerprint >> std::dec >> n) || version != SchemaVersion) {
+    schemaError(line, "unsupported header");
+  }
+  if (fingerprint != binInputFingerprint(circuit) || n != get_main_input_signal_no()) {
+    schemaError(line, "schema of a different circuit");
+  }
+
+  std::vector<InputSchemaEntry> entries;
+  std::set<std::string> names;
+  while (std::getline(in, text)) {
+    line++;
+    std::istringstream fields(text);
+    InputSchemaEntry entry;
+    if (!(fields >> entry.name)) continue;
+    if (!(fields >> entry.index >> entry.size)) schemaError(line, "expected name, index and size");
+    u64 d;
+    while (fields >> d) entry.dims.push_back(d);
+    if (!fields.eof()) schemaError(line, "invalid dimension");
+    if (!names.insert(entry.name).second) schemaError(line, "duplicate input " + entry.name);
+    std::string error = checkEntry(circuit, entry);
+    if (!error.empty()) schemaError(line, error);
+    entries.push_back(entry);
+  }
+  std::string error = checkCoverage(entries);
+  if (!error.empty()) schemaError(line, error);
+
+  return entries;
+}
+
+} // namespace
@@ -0,0 +1,47 @@
+#ifndef INPUTSCHEMA_HPP
+#define INPUTSCHEMA_HPP
+
+#include <string>
+#include <vector>
+
+#include "calcwit.hpp"
+#include "jsonloader.hpp"
+
+namespace CIRCUIT_NAME {
+
+/**
+ * Input schema: a text file shipped next to the .dat that lists the main
+ * inputs of the circuit, so names are resolved and checked once when the
+ * circuit is loaded instead of on every request.
+ *
+ *   # witnesscalc input schema 1 <fingerprint> <number of input signals>
+ *   <name> <index> <size> [<dimension> ...]
+ *   ...
+ *
+ * The fingerprint is binInputFingerprint() in hex, index is the position of
+ * the first signal of the input among all inputs, as in the binary input
+ * format, and the dimensions multiply to size (a scalar input has none).
+ */
+
+struct InputSchemaEntry {
+  std::string name;
+  u64 index;
+  u64 size;
+  std::vector<u64> dims;
+};
+
+/**
+ * Schema of circuit from the shapes of a complete example input, as
+ * returned by parseJsonBuffer().
+ */
+std::string formatInputSchema(const Circom_Circuit *circuit, const std::vector<JsonInputShape> &shapes);
+
+/**
+ * Parses schema and checks every entry against circuit. Throws
+ * std::runtime_error naming the first line that does not match.
+ */
+std::vector<InputSchemaEntry> loadInputSchema(const Circom_Circuit *circuit, const char *schema, unsigned long size);
+
+} // namespace
+
+#endif // INPUTSCHEMA_HPP
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <vector>
+#include "witnesscalc.h"
+#include "filemaploader.hpp"
+
+// Converts JSON inputs to the binary input format of witnesscalc_bin, so
+// they can be computed without parsing them again. With --schema it writes
+// the input schema of the circuit instead, using the JSON as an example.
+
+void writeOutput(const char *outBuffer, unsigned long outSize, std::string outFileName)
+{
+    FILE *write_ptr;
+    write_ptr = fopen(outFileName.c_str(),"wb");
+
+    if (write_ptr == NULL) {
+        std::string msg("Could not open ");
+        msg += outFileName + " for write";
+        throw std::system_error(errno, std::generic_category(), msg);
+    }
+
+    fwrite(outBuffer, outSize, 1, write_ptr);
+    fclose(write_ptr);
+}
+
+int main (int argc, char *argv[]) {
+
+    std::string cl(argv[0]);
+
+    bool montgomery = argc == 5 && std::string(argv[4]) == "--montgomery";
+    bool schema = argc == 5 && std::string(argv[1]) == "--schema";
+
+    if (argc != 4 && !montgomery && !schema) {
+        std::cout << "Usage: " << cl << " <circuit.dat> <input.json> <output.bin> [--montgomery]\n"
+                  << "       " << cl << " --schema <circuit.dat> <input.json> <output.inputs>\n";
+        return EXIT_FAILURE;
+    }
+    if (schema) {
+        argv++;
+    }
+
+    CIRCUIT_NAME::witnesscalc_circuit *circuit = NULL;
+
+    try {
+        std::string datfile(argv[1]);
+        std::string jsonfile(argv[2]);
+        std::string outFileName(argv[3]);
+
+        char errorMessage[256];
+
+        int error = CIRCUIT_NAME::witnesscalc_circuit_load_from_dat_file(datfile.c_str(), &circuit,
+                                errorMessage, sizeof(errorMessage));
+        if (error) {
+            std::cerr << errorMessage << '\n';
+            return EXIT_FAILURE;
+        }
+
+        FileMapLoader jsonLoader(jsonfile);
+
+        unsigned int flags = montgomery ? WITNESSCALC_BIN_MONTGOMERY : WITNESSCALC_BIN_NORMAL;
+        unsigned long outSize = 0;
+        std::vector<char> outBuffer;
+
+        // Asks for the size first, then converts into a buffer of that size.
+        for (int pass = 0; pass < 2; pass++) {
+            outBuffer.resize(outSize);
+            if (schema) {
+                error = CIRCUIT_NAME::witnesscalc_input_schema(circuit,
+                                jsonLoader.buffer, jsonLoader.size,
+                                outBuffer.data(), &outSize,
+                                errorMessage, sizeof(errorMessage));
+            } else {
+                error = CIRCUIT_NAME::witnesscalc_json_to_bin(circuit,
+                                jsonLoader.buffer, jsonLoader.size, flags,
+                                outBuffer.data(), &outSize,
+                                errorMessage, sizeof(errorMessage));
+            }
+            if (error != WITNESSCALC_ERROR_SHORT_BUFFER) {
+                break;
+            }
+        }
+
+        if (error) {
+            std::cerr << errorMessage << '\n';
+            CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+            return EXIT_FAILURE;
+        }
+
+        writeOutput(outBuffer.data(), outSize, outFileName);
+
+    } catch (std::exception* e) {
+        std::cerr << e->what() << '\n';
+        CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+        return EXIT_FAILURE;
+
+    } catch (std::exception& e) {
+        std::cerr << e.what() << '\n';
+        CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+        return EXIT_FAILURE;
+    }
+
+    CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,394 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+#include "jsonloader.hpp"
+
+namespace CIRCUIT_NAME {
+
+namespace {
+
+// Values are converted into blocks of this many elements before being
+// copied into the signal table.
+const uint BlockSize = 256;
+
+class JsonLoader {
+
+  Circom_CalcWit *ctx;
+  // When set, values are stored here, indexed from the first input signal,
+  // instead of being assigned to ctx.
+  FrElement *inputs;
+  u64 nStored;
+  std::vector<JsonInputShape> *shapes;
+
+  // Dimensions of the current value and, per nesting level, whether the
+  // array open at that level is the first one, whose length is counted.
+  std::vector<u64> dims;
+  std::vector<bool> counting;
+  const char *begin;
+  const char *p;
+  const char *end;
+
+  // Input signal being loaded: its name, first signal id and size, and the
+  // number of values seen so far (which may exceed size).
+  std::string key;
+  u64 signalOffset;
+  u64 signalSize;
+  u64 nValues;
+  u64 nFlushed;
+
+  FrElement block[BlockSize];
+  uint nBlock;
+
+  // Hashes of the signals loaded so far. A repeated key is an error: its
+  // signals are already assigned, and the circuit may even have run.
+  std::unordered_set<u64> loaded;
+
+  std::string token;
+
+  [[noreturn]] void syntaxError(const char *expected) {
+    std::ostringstream errStrStream;
+    errStrStream << "Invalid JSON input at offset " << (p - begin) << ": expected " << expected << "\n";
+    throw std::runtime_error(errStrStream.str());
+  }
+
+  int peek() const {
+    return p < end ? (unsigned char)*p : -1;
+  }
+
+  void skipSpace() {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+  }
+
+  void expect(char c, const char *what) {
+    skipSpace();
+    if (peek() != c) syntaxError(what);
+    p++;
+  }
+
+  static int hexDigit(int c) {
+    if ('0' <= c && c <= '9') return c - '0';
+    if ('a' <= c && c <= 'f') return c - 'a' + 10;
+    if ('A' <= c && c <= 'F') return c - 'A' + 10;
+    return -1;
+  }
+
+  unsigned readHex4() {
+    unsigned u = 0;
+    for (int i = 0; i < 4; i++) {
+      int d = hexDigit(peek());
+      if (d < 0) syntaxError("four hex digits");
+      u = (u << 4) | d;
+      p++;
+    }
+    return u;
+  }
+
+  void appendUtf8(std::string &s, unsigned u) {
+    if (u < 0x80) {
+      s += (char)u;
+    } else if (u < 0x800) {
+      s += (char)(0xC0 | (u >> 6));
+      s += (char)(0x80 | (u & 0x3F));
+    } else if (u < 0x10000) {
+      s += (char)(0xE0 | (u >> 12));
+      s += (char)(0x80 | ((u >> 6) & 0x3F));
+      s += (char)(0x80 | (u & 0x3F));
+    } else {
+      s += (char)(0xF0 | (u >> 18));
+      s += (char)(0x80 | ((u >> 12) & 0x3F));
+      s += (char)(0x80 | ((u >> 6) & 0x3F));
+      s += (char)(0x80 | (u & 0x3F));
+    }
+  }
+
+  // Reads the string starting at the opening quote into s, decoding escapes.
+  void readString(std::string &s) {
+    s.clear();
+    p++;
+    for (;;) {
+      const char *start = p;
+      while (p < end && *p != '"' && *p != '\\' && (unsigned char)*p >= 0x20) p++;
+      s.append(start, p - start);
+      int c = peek();
+      if (c == '"') {
+        p++;
+        return;
+      }
+      if (c != '\\') syntaxError("closing quote");
+      p++;
+      c = peek();
+      p++;
+      switch (c) {
+        case '"': s += '"'; break;
+        case '\\': s += '\\'; break;
+        case '/': s += '/'; break;
+        case 'b': s += '\b'; break;
+        case 'f': s += '\f'; break;
+        case 'n': s += '\n'; break;
+        case 'r': s += '\r'; break;
+        case 't': s += '\t'; break;
+        case 'u': {
+          unsigned u = readHex4();
+          if (0xD800 <= u && u < 0xDC00) {
+            if (peek() != '\\') syntaxError("low surrogate");
+            p++;
+            if (peek() != 'u') syntaxError("low surrogate");
+            p++;
+            unsigned lo = readHex4();
+            if (lo < 0xDC00 || lo >= 0xE000) syntaxError("low surrogate");
+            u = 0x10000 + ((u - 0xD800) << 10) + (lo - 0xDC00);
+          } else if (0xDC00 <= u && u < 0xE000) {
+            syntaxError("high surrogate");
+          }
+          appendUtf8(s, u);
+          break;
+        }
+        default:
+          p--;
+          syntaxError("escape sequence");
+      }
+    }
+  }
+
+  static bool checkValidNumber(const char *s, size_t n, uint base) {
+    for (size_t i = 0; i < n; i++) {
+      char c = s[i];
+      bool valid;
+      if (base == 16) {
+        valid = ('0' <= c && c <= '9') || ('a' <= c && c <= 'f') || ('A' <= c && c <= 'F');
+      } else {
+        valid = '0' <= c && c < char(int('0') + base);
+      }
+      if (!valid) return false;
+    }
+    return true;
+  }
+
+  // String values are decimal unless prefixed with 0b, 0o or 0x.
+  void parseStringValue(FrElement *v) {
+    readString(token);
+    uint base = 10;
+    size_t skip = 0;
+    if (token.size() >= 2 && token[0] == '0') {
+      switch (token[1]) {
+        case 'b': case 'B': base = 2; skip = 2; break;
+        case 'o': case 'O': base = 8; skip = 2; break;
+        case 'x': case 'X': base = 16; skip = 2; break;
+      }
+    }
+    if (!checkValidNumber(token.data() + skip, token.size() - skip, base)) {
+      std::ostringstream errStrStream;
+      errStrStream << "Invalid number in JSON input: " << token << "\n";
+      throw std::runtime_error(errStrStream.str());
+    }
+    Fr_str2element(v, token.c_str() + skip, base);
+  }
+
+  // JSON numbers go through a double, rounded to an integer, as they always
+  // have. Integers short enough to be exact doubles are used as written.
+  void parseNumberValue(FrElement *v) {
+    const char *start = p;
+    bool isInteger = true;
+    if (peek() == '-') p++;
+    const char *digits = p;
+    while (p < end && '0' <= *p && *p <= '9') p++;
+    if (p == digits) syntaxError("digit");
+    size_t nDigits = p - digits;
+    if (peek() == '.') {
+      isInteger = false;
+      p++;
+      const char *frac = p;
+      while (p < end && '0' <= *p && *p <= '9') p++;
+      if (p == frac) syntaxError("digit");
+    }
+    if (peek() == 'e' || peek() == 'E') {
+      isInteger = false;
+      p++;
+      if (peek() == '+' || peek() == '-') p++;
+      const char *exp = p;
+      while (p < end && '0' <= *p && *p <= '9') p++;
+      if (p == exp) syntaxError("digit");
+    }
+    token.assign(start, p - start);
+    if (isInteger && nDigits <= 15) {
+      Fr_str2element(v, token.c_str(), 10);
+      return;
+    }
+    char buf[400];
+    snprintf(buf, sizeof(buf), "%.0f", strtod(token.c_str(), NULL));
+    Fr_str2element(v, buf, 10);
+  }
+
+  void flushBlock() {
+    if (inputs) {
+      u64 i = signalOffset - get_main_input_signal_start() + nFlushed;
+      memcpy(&inputs[i], block, nBlock*sizeof(FrElement));
+      nStored += nBlock;
+      nFlushed += nBlock;
+      nBlock = 0;
+      return;
+    }
+    try {
+      ctx->setInputSignalRangeAt(signalOffset + nFlushed, block, nBlock);
+    } catch (std::runtime_error &e) {
+      std::ostringstream errStrStream;
+      errStrStream << "Error setting signal: " << key << "\n" << e.what();
+      throw std::runtime_error(errStrStream.str());
+    }
+    nFlushed += nBlock;
+    nBlock = 0;
+  }
+
+  // Values past the signal size are only counted, so the error can be
+  // reported once the whole value has been read. A full block is only
+  // flushed when another value for the signal follows, which keeps the block
+  // that completes the signal until its count has been checked.
+  FrElement *nextValue() {
+    if (nValues++ >= signalSize) return &block[0];
+    if (nBlock == BlockSize) flushBlock();
+    return &block[nBlock++];
+  }
+
+  void parseScalar() {
+    int c = peek();
+    if (c == '"') {
+      parseStringValue(nextValue());
+    } else if (c == '-' || ('0' <= c && c <= '9')) {
+      parseNumberValue(nextValue());
+    } else if (c == '{' || c == 't' || c == 'f' || c == 'n') {
+      throw std::runtime_error("Invalid JSON type");
+    } else {
+      syntaxError("value");
+    }
+  }
+
+  // Reads one value, flattening nested arrays with a depth counter instead
+  // of recursion.
+  void parseValue() {
+    int depth = 0;
+    dims.clear();
+    counting.clear();
+    do {
+      skipSpace();
+      if (shapes && depth > 0 && counting[depth-1]) dims[depth-1]++;
+      if (peek() == '[') {
+        p++;
+        depth++;
+        if (shapes) {
+          bool first = dims.size() < (size_t)depth;
+          if (first) {
+            dims.push_back(0);
+            counting.push_back(true);
+          } else {
+            counting[depth-1] = false;
+          }
+        }
+        skipSpace();
+        if (peek() != ']') continue;
+      } else {
+        parseScalar();
+      }
+      skipSpace();
+      while (depth > 0 && peek() == ']') {
+        p++;
+        if (shapes) counting[depth-1] = false;
+        depth--;
+        skipSpace();
+      }
+      if (depth > 0) expect(',', "',' or ']'");
+    } while (depth > 0);
+  }
+
+  void loadSignal() {
+    u64 h = fnv1a(key);
+    if (!loaded.insert(h).second) {
+      std::ostringstream errStrStream;
+      errStrStream << "Error loading signal " << key << ": Duplicate key\n";
+      throw std::runtime_error(errStrStream.str());
+    }
+    signalOffset = ctx->getInputSignalOffset(h);
+    signalSize = ctx->getInputSignalSize(h);
+    nValues = 0;
+    nFlushed = 0;
+    nBlock = 0;
+
+    parseValue();
+
+    if (nValues < signalSize) {
+      std::ostringstream errStrStream;
+      errStrStream << "Error loading signal " << key << ": Not enough values\n";
+      throw std::runtime_error(errStrStream.str());
+    }
+    if (nValues > signalSize) {
+      std::ostringstream errStrStream;
+      errStrStream << "Error loading signal " << key << ": Too many values\n";
+      throw std::runtime_error(errStrStream.str());
+    }
+    if (nBlock > 0) flushBlock();
+
+    if (shapes) {
+      JsonInputShape shape;
+      shape.name = key;
+      shape.signalOffset = signalOffset;
+      shape.size = signalSize;
+      shape.dims = dims;
+      shapes->push_back(shape);
+    }
+  }
+
+public:
+
+  JsonLoader(Circom_CalcWit *_ctx, FrElement *_inputs, std::vector<JsonInputShape> *_shapes,
+             const char *json, size_t size)
+    : ctx(_ctx), inputs(_inputs), nStored(0), shapes(_shapes), begin(json), p(json), end(json + size) {}
+
+  void load() {
+    expect('{', "'{'");
+    skipSpace();
+    if (peek() == '}') {
+      p++;
+      if (!inputs) ctx->tryRunCircuit();
+    } else {
+      for (;;) {
+        skipSpace();
+        if (peek() != '"') syntaxError("signal name");
+        readString(key);
+        expect(':', "':'");
+        loadSignal();
+        skipSpace();
+        if (peek() == '}') {
+          p++;
+          break;
+        }
+        expect(',', "',' or '}'");
+      }
+    }
+    skipSpace();
+    if (p != end) syntaxError("end of input");
+  }
+
+  u64 stored() const {
+    return nStored;
+  }
+};
+
+} // namespace
+
+void loadJsonBuffer(Circom_CalcWit *ctx, const char *json, size_t size) {
+  JsonLoader loader(ctx, NULL, NULL, json, size);
+  loader.load();
+}
+
+u64 parseJsonBuffer(Circom_CalcWit *ctx, const char *json, size_t size, FrElement *inputs,
+                    std::vector<JsonInputShape> *shapes) {
+  JsonLoader loader(ctx, inputs, shapes, json, size);
+  loader.load();
+  return loader.stored();
+}
+
+} //namespace
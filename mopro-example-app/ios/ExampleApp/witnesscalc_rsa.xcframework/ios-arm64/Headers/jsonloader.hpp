@@ -0,0 +1,41 @@
+#ifndef __JSONLOADER_H
+#define __JSONLOADER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "calcwit.hpp"
+
+namespace CIRCUIT_NAME {
+
+// Assigns the inputs in the JSON object json[0..size) to ctx in a single
+// pass over the text. Each key names an input signal and its value is a
+// number, a decimal string, a "0b"/"0o"/"0x" prefixed string, or arrays of
+// them nested to any depth, which are flattened in order. Values are parsed
+// straight into blocks of field elements and handed to
+// setInputSignalRangeAt(), so no document tree and no per-signal vector are
+// built. Throws std::runtime_error on malformed input or a value count that
+// does not match the signal size, before the circuit runs.
+void loadJsonBuffer(Circom_CalcWit *ctx, const char *json, size_t size);
+
+// Where a key of a JSON input went: its first signal id, its number of
+// values and the dimensions of its value, read from the first array at each
+// nesting level.
+struct JsonInputShape {
+  std::string name;
+  u64 signalOffset;
+  u64 size;
+  std::vector<u64> dims;
+};
+
+// Same as loadJsonBuffer() but stores the values in inputs, indexed from the
+// first input signal, instead of assigning them, so the circuit never runs.
+// ctx is only used to look up signal names. If shapes is given, it receives
+// the shape of every key. Returns the number of values stored.
+u64 parseJsonBuffer(Circom_CalcWit *ctx, const char *json, size_t size, FrElement *inputs,
+                    std::vector<JsonInputShape> *shapes = NULL);
+
+} //namespace
+
+#endif // __JSONLOADER_H
@@ -6,71 +6,106 @@
 #define handle_error(msg) \
            do { perror(msg); exit(EXIT_FAILURE); } while (0)
 
-void writeBinWitness(char *witnessBuffer, unsigned long witnessSize, std::string wtnsFileName)
+// Inputs in the binary format of witnesscalc_bin, as written by json2bin,
+// are recognized by their .bin extension.
+bool isBinInput(const std::string &fileName)
 {
-    FILE *write_ptr;
-    write_ptr = fopen(wtnsFileName.c_str(),"wb");
+    const std::string ext(".bin");
+    return fileName.size() > ext.size() &&
+           fileName.compare(fileName.size() - ext.size(), ext.size(), ext) == 0;
+}
 
-    if (write_ptr == NULL) {
-        std::string msg("Could not open ");
-        msg += wtnsFileName + " for write";
-        throw std::system_error(errno, std::generic_category(), msg);
+// Computes the witness of the input in inputBuffer into witnessBuffer, or
+// only returns its size in witnessSize, with WITNESSCALC_ERROR_SHORT_BUFFER,
+// when witnessBuffer is NULL.
+int calcWitness(const CIRCUIT_NAME::witnesscalc_circuit *circuit, bool binInput,
+                const char *inputBuffer, unsigned long inputSize,
+                unsigned int witnessFlags,
+                char *witnessBuffer, unsigned long *witnessSize,
+                char *errorMessage, unsigned long errorMessageSize)
+{
+    if (binInput) {
+        return CIRCUIT_NAME::witnesscalc_bin_with_circuit_flags(circuit, inputBuffer, inputSize,
+                                witnessFlags,
+                                witnessBuffer, witnessSize,
+                                errorMessage, errorMessageSize);
     }
-
-    fwrite(witnessBuffer, witnessSize, 1, write_ptr);
-    fclose(write_ptr);
+    return CIRCUIT_NAME::witnesscalc_with_circuit_flags(circuit, inputBuffer, inputSize,
+                                witnessFlags,
+                                witnessBuffer, witnessSize,
+                                errorMessage, errorMessageSize);
 }
 
-static const size_t WitnessBufferSize = 8*1024*1024;
-static char WitnessBuffer[WitnessBufferSize];
-
 int main (int argc, char *argv[]) {
 
     std::string cl(argv[0]);
 
-    if (argc!=3) {
-        std::cout << "Usage: " << cl << " <input.json> <output.wtns>\n";
+    bool montgomery = argc == 4 && std::string(argv[3]) == "--montgomery";
+
+    if (argc != 3 && !montgomery) {
+        std::cout << "Usage: " << cl << " <input.json|input.bin> <output.wtns> [--montgomery]\n";
         return EXIT_FAILURE;
     }
 
+    CIRCUIT_NAME::witnesscalc_circuit *circuit = NULL;
+    int error = WITNESSCALC_OK;
+
     try {
         std::string datfile = cl + ".dat";
         std::string jsonfile(argv[1]);
         std::string wtnsFileName(argv[2]);
 
-        size_t witnessSize = sizeof(WitnessBuffer);
-        char   errorMessage[256];
+        char errorMessage[256];
 
         FileMapLoader jsonLoader(jsonfile);
+        bool binInput = isBinInput(jsonfile);
+        unsigned int witnessFlags = montgomery ? WITNESSCALC_WTNS_MONTGOMERY : WITNESSCALC_WTNS_NORMAL;
+
+        error = CIRCUIT_NAME::witnesscalc_circuit_load_from_dat_file(datfile.c_str(), &circuit,
+                                errorMessage, sizeof(errorMessage));
 
-        int error = CIRCUIT_NAME::witnesscalc_from_dat_file(datfile.c_str(),
-                                jsonLoader.buffer, jsonLoader.size,
-                                WitnessBuffer, &witnessSize,
+        // The .wtns file is sized up front and the witness serialized
+        // straight into its mapping.
+        unsigned long witnessSize = 0;
+        if (!error) {
+            error = calcWitness(circuit, binInput, jsonLoader.buffer, jsonLoader.size, witnessFlags,
+                                NULL, &witnessSize,
                                 errorMessage, sizeof(errorMessage));
+        }
 
         if (error == WITNESSCALC_ERROR_SHORT_BUFFER) {
+            FileMapWriter wtns(wtnsFileName, witnessSize);
 
-            std::cerr << "Error: Short buffer for witness."
-                      << " It should " << witnessSize << " bytes at least." << '\n';
-            return EXIT_FAILURE;
+            error = calcWitness(circuit, binInput, jsonLoader.buffer, jsonLoader.size, witnessFlags,
+                                wtns.buffer, &witnessSize,
+                                errorMessage, sizeof(errorMessage));
+            if (error) {
+                wtns.discard();
+            } else {
+                try {
+                    wtns.commit();
+                } catch (...) {
+                    wtns.discard();
+                    throw;
+                }
+            }
         }
-        else if (error) {
 
+        if (error) {
             std::cerr << errorMessage << '\n';
-            return EXIT_FAILURE;
         }
 
-        writeBinWitness(WitnessBuffer, witnessSize, wtnsFileName);
-
     } catch (std::exception* e) {
         std::cerr << e->what() << '\n';
-        return EXIT_FAILURE;
+        error = WITNESSCALC_ERROR;
 
     } catch (std::exception& e) {
         std::cerr << e.what() << '\n';
-        return EXIT_FAILURE;
+        error = WITNESSCALC_ERROR;
     }
 
-    return EXIT_SUCCESS;
+    CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+
+    return error ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
@@ -1,10 +1,14 @@
 #include <iostream>
+#include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <string>
 #include <cstdint>
 #include <cstring>
+#include <vector>
 #include "fr.hpp"
+#include "calcwit.hpp"
+#include "witnesscalc.h"
 
 int tests_run = 0;
 int tests_failed = 0;
@@ -5463,6 +5467,348 @@ void Fr_bnot_unit_test()
     Fr_bnot_test(r23, m3, 23);
 }
 
+void check_Result(bool passed, int idx, std::string test_name, const std::string &details)
+{
+    if (!passed)
+    {
+        std::cout << test_name << ":" << idx << " failed!" << std::endl;
+        std::cout << details << std::endl;
+        std::cout << std::endl;
+        tests_failed++;
+    }
+
+    tests_run++;
+}
+
+// The library tests run the circuit of TESTS_DAT_FILE on the example input
+// of TESTS_INPUT_FILE, both set by the build.
+
+std::string read_file(const char *name)
+{
+    std::ifstream file(name, std::ios::binary);
+    std::ostringstream data;
+
+    data << file.rdbuf();
+    return data.str();
+}
+
+CIRCUIT_NAME::witnesscalc_circuit *load_test_circuit()
+{
+    CIRCUIT_NAME::witnesscalc_circuit *circuit = NULL;
+    char error[256];
+
+    if (CIRCUIT_NAME::witnesscalc_circuit_load_from_dat_file(TESTS_DAT_FILE, &circuit,
+                                                             error, sizeof(error))) {
+        std::cout << TESTS_DAT_FILE << ": " << error << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return circuit;
+}
+
+// Runs calc(buffer, size, ...) the way witnesscalc_with_circuit and its
+// variants are called: first for the size, then for the output.
+template <typename Calc>
+int calc_output(Calc calc, std::vector<char> &out, std::string &error)
+{
+    char msg[256] = "";
+    unsigned long size = 0;
+
+    int result = calc(NULL, &size, msg, sizeof(msg));
+    if (result == WITNESSCALC_ERROR_SHORT_BUFFER) {
+        out.resize(size);
+        result = calc(out.data(), &size, msg, sizeof(msg));
+        out.resize(size);
+    }
+    error = msg;
+    return result;
+}
+
+int calc_json_wtns(const CIRCUIT_NAME::witnesscalc_circuit *circuit, const std::string &json,
+                   std::vector<char> &wtns, std::string &error)
+{
+    return calc_output([&](char *buffer, unsigned long *size, char *msg, unsigned long msgSize) {
+        return CIRCUIT_NAME::witnesscalc_with_circuit(circuit, json.data(), json.size(),
+                                                      buffer, size, msg, msgSize);
+    }, wtns, error);
+}
+
+int calc_bin_wtns(const CIRCUIT_NAME::witnesscalc_circuit *circuit, const std::vector<char> &bin,
+                  std::vector<char> &wtns, std::string &error)
+{
+    return calc_output([&](char *buffer, unsigned long *size, char *msg, unsigned long msgSize) {
+        return CIRCUIT_NAME::witnesscalc_bin_with_circuit(circuit, bin.data(), bin.size(),
+                                                          buffer, size, msg, msgSize);
+    }, wtns, error);
+}
+
+int json_to_bin(const CIRCUIT_NAME::witnesscalc_circuit *circuit, const std::string &json,
+                unsigned int flags, std::vector<char> &bin, std::string &error)
+{
+    return calc_output([&](char *buffer, unsigned long *size, char *msg, unsigned long msgSize) {
+        return CIRCUIT_NAME::witnesscalc_json_to_bin(circuit, json.data(), json.size(), flags,
+                                                     buffer, size, msg, msgSize);
+    }, bin, error);
+}
+
+// Binary inputs are rejected before the circuit runs when their header or
+// elements are wrong.
+void witnesscalc_bin_rejects(const CIRCUIT_NAME::witnesscalc_circuit *circuit, const std::vector<char> &bin,
+                             const std::string &expected, int idx)
+{
+    std::vector<char> wtns;
+    std::string error;
+
+    int result = calc_bin_wtns(circuit, bin, wtns, error);
+
+    check_Result(result == WITNESSCALC_ERROR && error.find(expected) != std::string::npos,
+                 idx, "witnesscalc_bin_rejects",
+                 "expected \"" + expected + "\", got \"" + error + "\"");
+}
+
+void witnesscalc_json_to_bin_unit_test()
+{
+    CIRCUIT_NAME::witnesscalc_circuit *circuit = load_test_circuit();
+    std::string json = read_file(TESTS_INPUT_FILE);
+    std::vector<char> reference, wtns, bin, mbin;
+    std::string error;
+
+    int result = calc_json_wtns(circuit, json, reference, error);
+    check_Result(result == WITNESSCALC_OK, 0, __func__, "witness from JSON: " + error);
+
+    // Both element forms round-trip to the witness of the JSON input.
+    result = json_to_bin(circuit, json, WITNESSCALC_BIN_NORMAL, bin, error);
+    check_Result(result == WITNESSCALC_OK, 1, __func__, "json_to_bin: " + error);
+    result = calc_bin_wtns(circuit, bin, wtns, error);
+    check_Result(result == WITNESSCALC_OK && wtns == reference, 2, __func__, "normal round trip: " + error);
+
+    result = json_to_bin(circuit, json, WITNESSCALC_BIN_MONTGOMERY, mbin, error);
+    check_Result(result == WITNESSCALC_OK && mbin.size() == bin.size() && mbin != bin,
+                 3, __func__, "json_to_bin Montgomery: " + error);
+    result = calc_bin_wtns(circuit, mbin, wtns, error);
+    check_Result(result == WITNESSCALC_OK && wtns == reference, 4, __func__, "Montgomery round trip: " + error);
+
+    // Too small an output buffer reports the size needed.
+    char header[32];
+    unsigned long size = sizeof(header);
+    char msg[256];
+    result = CIRCUIT_NAME::witnesscalc_json_to_bin(circuit, json.data(), json.size(),
+                                                   WITNESSCALC_BIN_NORMAL, header, &size, msg, sizeof(msg));
+    check_Result(result == WITNESSCALC_ERROR_SHORT_BUFFER && size == bin.size(), 5, __func__, "short buffer");
+
+    std::vector<char> bad = bin;
+    bad[16] ^= 1;
+    witnesscalc_bin_rejects(circuit, bad, "different circuit", 10);
+
+    bad = bin;
+    bad[0] = 'x';
+    witnesscalc_bin_rejects(circuit, bad, "bad magic", 11);
+
+    // Elements equal to q, or above it, are not reduced.
+    bad = bin;
+    std::memcpy(&bad[32 + 5 * 32], &Fr_q.longVal, 32);
+    witnesscalc_bin_rejects(circuit, bad, "input 5 is not reduced", 12);
+
+    bad = mbin;
+    std::memset(&bad[bad.size() - 32], 0xff, 32);
+    witnesscalc_bin_rejects(circuit, bad, "is not reduced", 13);
+
+    // Truncated anywhere: inside the header, right after it or in the last
+    // element.
+    witnesscalc_bin_rejects(circuit, std::vector<char>(bin.begin(), bin.begin() + 10), "bad magic", 14);
+    witnesscalc_bin_rejects(circuit, std::vector<char>(bin.begin(), bin.begin() + 32), "wrong number of inputs", 15);
+    witnesscalc_bin_rejects(circuit, std::vector<char>(bin.begin(), bin.end() - 1), "wrong number of inputs", 16);
+
+    CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+}
+
+// A key given twice is rejected, both when the inputs are assigned to the
+// circuit and when they are only parsed.
+void witnesscalc_json_duplicate_key_unit_test()
+{
+    CIRCUIT_NAME::witnesscalc_circuit *circuit = load_test_circuit();
+    std::string json = read_file(TESTS_INPUT_FILE);
+    std::string first = json.substr(0, json.find(']') + 1);
+    std::string twice = first + "," + json.substr(1);
+    std::vector<char> wtns, bin;
+    std::string error;
+
+    int result = calc_json_wtns(circuit, twice, wtns, error);
+    check_Result(result == WITNESSCALC_ERROR && error.find("Duplicate key") != std::string::npos,
+                 0, __func__, "witnesscalc: " + error);
+
+    result = json_to_bin(circuit, twice, WITNESSCALC_BIN_NORMAL, bin, error);
+    check_Result(result == WITNESSCALC_ERROR && error.find("Duplicate key") != std::string::npos,
+                 1, __func__, "json_to_bin: " + error);
+
+    // Repeated after every other key, when all inputs are already set.
+    std::string last = json.substr(0, json.rfind('}')) + "," + first.substr(1) + "}";
+    result = calc_json_wtns(circuit, last, wtns, error);
+    check_Result(result == WITNESSCALC_ERROR && error.find("Duplicate key") != std::string::npos,
+                 2, __func__, "witnesscalc, last key: " + error);
+
+    CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+}
+
+int input_schema(const CIRCUIT_NAME::witnesscalc_circuit *circuit, const std::string &json,
+                 std::string &schema, std::string &error)
+{
+    std::vector<char> text;
+
+    int result = calc_output([&](char *buffer, unsigned long *size, char *msg, unsigned long msgSize) {
+        return CIRCUIT_NAME::witnesscalc_input_schema(circuit, json.data(), json.size(),
+                                                      buffer, size, msg, msgSize);
+    }, text, error);
+    schema.assign(text.begin(), text.end());
+    return result;
+}
+
+// Checks schema against circuit: expected is empty if it must be accepted,
+// otherwise part of the error it must be rejected with.
+void witnesscalc_schema_check_test(const CIRCUIT_NAME::witnesscalc_circuit *circuit, const std::string &schema,
+                                   const std::string &expected, int idx)
+{
+    char msg[256] = "";
+
+    int result = CIRCUIT_NAME::witnesscalc_input_schema_check(circuit, schema.data(), schema.size(),
+                                                              msg, sizeof(msg));
+    std::string error = msg;
+    bool passed = expected.empty()
+                ? result == WITNESSCALC_OK
+                : result == WITNESSCALC_ERROR && error.find(expected) != std::string::npos;
+
+    check_Result(passed, idx, __func__, "expected \"" + expected + "\", got \"" + error + "\"");
+}
+
+// Replaces the first occurrence of from in text with to.
+std::string replaced(std::string text, const std::string &from, const std::string &to)
+{
+    return text.replace(text.find(from), from.size(), to);
+}
+
+void witnesscalc_input_schema_unit_test()
+{
+    CIRCUIT_NAME::witnesscalc_circuit *circuit = load_test_circuit();
+    std::string json = read_file(TESTS_INPUT_FILE);
+    std::string datFile = TESTS_DAT_FILE;
+    std::string shipped = read_file((datFile.substr(0, datFile.size() - 4) + ".inputs").c_str());
+    std::string schema, error;
+
+    // The schema derived from the example input is the one shipped with the
+    // circuit, and both match it.
+    int result = input_schema(circuit, json, schema, error);
+    check_Result(result == WITNESSCALC_OK && schema == shipped, 0, __func__, "schema: " + error);
+    witnesscalc_schema_check_test(circuit, schema, "", 1);
+    witnesscalc_schema_check_test(circuit, shipped, "", 2);
+
+    // Lines in another order and blank lines are fine.
+    std::string line0 = "modulus 0 32 32\n";
+    witnesscalc_schema_check_test(circuit, replaced(schema, line0, "") + "\n" + line0, "", 3);
+
+    std::string header = schema.substr(0, schema.find('\n') + 1);
+    std::string fingerprint = header.substr(header.size() - 20, 16);
+    std::string other = fingerprint;
+    other[0] = other[0] == '0' ? '1' : '0';
+
+    witnesscalc_schema_check_test(circuit, "modulus 0 32 32\n", "not an input schema", 10);
+    witnesscalc_schema_check_test(circuit, replaced(schema, fingerprint, other), "different circuit", 11);
+    witnesscalc_schema_check_test(circuit, replaced(schema, " 96\n", " 95\n"), "different circuit", 12);
+    witnesscalc_schema_check_test(circuit, replaced(schema, "modulus 0 32", "modulus 32 32"), "does not match the circuit", 13);
+    witnesscalc_schema_check_test(circuit, replaced(schema, "modulus 0 32 32", "modulus 0 32 4 4"), "dimensions of modulus", 14);
+    witnesscalc_schema_check_test(circuit, replaced(schema, "modulus ", "modulo "), "no input modulo", 15);
+    witnesscalc_schema_check_test(circuit, replaced(schema, line0, ""), "inputs overlap or are missing", 16);
+    witnesscalc_schema_check_test(circuit, schema + line0, "duplicate input modulus", 17);
+    witnesscalc_schema_check_test(circuit, replaced(schema, "modulus 0 32 32", "modulus 0 32 x"), "invalid dimension", 18);
+
+    CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+}
+
+int select_witnesses(const CIRCUIT_NAME::witnesscalc_circuit *circuit, const std::string &json,
+                     const std::vector<unsigned long> &indices, bool useIndices, unsigned long n,
+                     std::vector<char> &out, std::string &error)
+{
+    return calc_output([&](char *buffer, unsigned long *size, char *msg, unsigned long msgSize) {
+        return CIRCUIT_NAME::witnesscalc_select_with_circuit(circuit, json.data(), json.size(),
+                                                             useIndices ? indices.data() : NULL, n,
+                                                             buffer, size, msg, msgSize);
+    }, out, error);
+}
+
+// Whether out holds, in order, the witnesses indices of the .wtns in wtns.
+bool selects(const std::vector<char> &wtns, const std::vector<unsigned long> &indices, const std::vector<char> &out)
+{
+    const size_t n8 = Fr_N64*8;
+    const char *data = wtns.data() + 44 + n8;
+
+    if (out.size() != indices.size() * n8) return false;
+    for (size_t i = 0; i < indices.size(); i++) {
+        if (std::memcmp(&out[i * n8], data + indices[i] * n8, n8) != 0) return false;
+    }
+    return true;
+}
+
+void witnesscalc_select_unit_test()
+{
+    CIRCUIT_NAME::witnesscalc_circuit *circuit = load_test_circuit();
+    std::string json = read_file(TESTS_INPUT_FILE);
+    std::vector<char> wtns, out, bin;
+    std::string error;
+
+    int result = calc_json_wtns(circuit, json, wtns, error);
+    check_Result(result == WITNESSCALC_OK, 0, __func__, "witness from JSON: " + error);
+
+    // The header section ends with n8, q and the number of witnesses.
+    uint32_t n;
+    std::memcpy(&n, wtns.data() + 28 + Fr_N64*8, 4);
+    unsigned long nWitness = n;
+
+    // No indices: witnesses 1 to n, the public signals.
+    std::vector<unsigned long> first = {1, 2, 3, 4};
+    result = select_witnesses(circuit, json, first, false, first.size(), out, error);
+    check_Result(result == WITNESSCALC_OK && selects(wtns, first, out), 1, __func__, "public signals: " + error);
+
+    // An explicit list, out of order and with repetitions, including the
+    // constant 1 and the last witness.
+    std::vector<unsigned long> list = {nWitness - 1, 7, 0, 7, 2, 1000, 3};
+    result = select_witnesses(circuit, json, list, true, list.size(), out, error);
+    check_Result(result == WITNESSCALC_OK && selects(wtns, list, out), 2, __func__, "explicit list: " + error);
+
+    // Every witness, in order: the data section of the full witness.
+    std::vector<unsigned long> all(nWitness);
+    for (unsigned long i = 0; i < nWitness; i++) all[i] = i;
+    result = select_witnesses(circuit, json, all, true, all.size(), out, error);
+    check_Result(result == WITNESSCALC_OK && selects(wtns, all, out), 3, __func__, "all witnesses: " + error);
+
+    // The binary input selects the same witnesses.
+    result = json_to_bin(circuit, json, WITNESSCALC_BIN_NORMAL, bin, error);
+    unsigned long size = list.size() * Fr_N64*8;
+    out.assign(size, 0);
+    char msg[256] = "";
+    result = CIRCUIT_NAME::witnesscalc_bin_select_with_circuit(circuit, bin.data(), bin.size(),
+                                                               list.data(), list.size(),
+                                                               out.data(), &size, msg, sizeof(msg));
+    check_Result(result == WITNESSCALC_OK && selects(wtns, list, out), 4, __func__, std::string("binary input: ") + msg);
+
+    // Too small a buffer reports the size needed without running the circuit.
+    size = 0;
+    result = CIRCUIT_NAME::witnesscalc_select_with_circuit(circuit, json.data(), json.size(),
+                                                           list.data(), list.size(),
+                                                           NULL, &size, msg, sizeof(msg));
+    check_Result(result == WITNESSCALC_ERROR_SHORT_BUFFER && size == list.size() * Fr_N64*8,
+                 5, __func__, "short buffer");
+
+    // Indices past the last witness are rejected.
+    std::vector<unsigned long> outside = {1, nWitness};
+    result = select_witnesses(circuit, json, outside, true, outside.size(), out, error);
+    check_Result(result == WITNESSCALC_ERROR, 6, __func__, "index nWitness accepted");
+    outside = {(unsigned long)-1};
+    result = select_witnesses(circuit, json, outside, true, outside.size(), out, error);
+    check_Result(result == WITNESSCALC_ERROR, 7, __func__, "index -1 accepted");
+    result = select_witnesses(circuit, json, first, false, nWitness, out, error);
+    check_Result(result == WITNESSCALC_ERROR, 8, __func__, "nWitness public signals accepted");
+
+    CIRCUIT_NAME::witnesscalc_circuit_free(circuit);
+}
+
 void print_results()
 {
     std::cout << "Results: " << std::dec << tests_run << " tests were run, " << tests_failed << " failed." << std::endl;
@@ -5603,6 +5949,10 @@ int main()
     Fr_bnot_unit_test();
     Fr_leq_s1l2n_unit_test();
     Fr_lnot_unit_test();
+    witnesscalc_json_to_bin_unit_test();
+    witnesscalc_json_duplicate_key_unit_test();
+    witnesscalc_input_schema_unit_test();
+    witnesscalc_select_unit_test();
 
 
     print_results();
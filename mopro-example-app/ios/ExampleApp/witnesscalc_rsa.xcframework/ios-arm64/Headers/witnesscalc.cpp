@@ -2,57 +2,83 @@
 #include "filemaploader.hpp"
 #include "calcwit.hpp"
 #include "circom.hpp"
-#include <nlohmann/json.hpp>
+#include "jsonloader.hpp"
+#include "bininput.hpp"
+#include "inputschema.hpp"
 #include <sstream>
+#include <algorithm>
 #include <memory>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace CIRCUIT_NAME {
 
-using json = nlohmann::json;
-
-Circom_Circuit* loadCircuit(const void *buffer, unsigned long buffer_size) {
+/**
+ * With zeroCopy the input hash map, witness list and constants point straight
+ * into buffer, which then has to stay valid as long as the circuit is alive.
+ */
+Circom_Circuit* loadCircuit(const void *buffer, unsigned long buffer_size, bool zeroCopy = false) {
     if (buffer_size % sizeof(u32) != 0) {
       throw std::runtime_error("Invalid circuit file: wrong buffer_size");
     }
 
-    Circom_Circuit *circuit = new Circom_Circuit;
+    // The witness list is read as u64, so fall back to copying when the
+    // buffer is not suitably aligned.
+    if ((uintptr_t)buffer % alignof(u64) != 0) {
+      zeroCopy = false;
+    }
+
+    std::unique_ptr<Circom_Circuit> circuit(new Circom_Circuit);
+    circuit->zeroCopy = zeroCopy;
 
     u8* bdata = (u8*)buffer;
 
-    circuit->InputHashMap = new HashSignalInfo[get_size_of_input_hashmap()];
     uint dsize = get_size_of_input_hashmap()*sizeof(HashSignalInfo);
     if (buffer_size < dsize) {
         throw std::runtime_error("Invalid circuit file: buffer_size <= dsize");
     }
-    memcpy((void *)(circuit->InputHashMap), (void *)bdata, dsize);
+    if (zeroCopy) {
+        circuit->InputHashMap = (HashSignalInfo*)bdata;
+    } else {
+        circuit->InputHashMap = new HashSignalInfo[get_size_of_input_hashmap()];
+        memcpy((void *)(circuit->InputHashMap), (void *)bdata, dsize);
+    }
 
-    circuit->witness2SignalList = new u64[get_size_of_witness()];
     uint inisize = dsize;
     dsize = get_size_of_witness()*sizeof(u64);
     if (buffer_size < dsize + inisize) {
         throw std::runtime_error("Invalid circuit file: buffer_size <= dsize + inisize");
     }
-    memcpy((void *)(circuit->witness2SignalList), (void *)(bdata+inisize), dsize);
+    if (zeroCopy) {
+        circuit->witness2SignalList = (u64*)(bdata+inisize);
+    } else {
+        circuit->witness2SignalList = new u64[get_size_of_witness()];
+        memcpy((void *)(circuit->witness2SignalList), (void *)(bdata+inisize), dsize);
+    }
 
-    circuit->circuitConstants = new FrElement[get_size_of_constants()];
-    if (get_size_of_constants()>0) {
-      inisize += dsize;
-      dsize = get_size_of_constants()*sizeof(FrElement);
-      if (buffer_size < dsize + inisize) {
-        throw std::runtime_error("Invalid circuit file: buffer_size <= dsize + inisize");
-      }
-      memcpy((void *)(circuit->circuitConstants), (void *)(bdata+inisize), dsize);
+    inisize += dsize;
+    dsize = get_size_of_constants()*sizeof(FrElement);
+    if (buffer_size < dsize + inisize) {
+      throw std::runtime_error("Invalid circuit file: buffer_size <= dsize + inisize");
+    }
+    if (zeroCopy) {
+        circuit->circuitConstants = (FrElement*)(bdata+inisize);
+    } else {
+        circuit->circuitConstants = new FrElement[get_size_of_constants()];
+        if (get_size_of_constants()>0) {
+          memcpy((void *)(circuit->circuitConstants), (void *)(bdata+inisize), dsize);
+        }
     }
 
     std::map<u32,IODefPair> templateInsId2IOSignalInfo1;
     if (get_size_of_io_map()>0) {
-      u32 index[get_size_of_io_map()];
       inisize += dsize;
       dsize = get_size_of_io_map()*sizeof(u32);
       if (buffer_size < dsize + inisize) {
         throw std::runtime_error("Invalid circuit file: buffer_size <= dsize + inisize");
       }
-      memcpy((void *)index, (void *)(bdata+inisize), dsize);
+      u32* index = (u32*)(bdata+inisize);
       inisize += dsize;
       if (inisize % sizeof(u32) != 0) {
         throw std::runtime_error("Invalid circuit file: wrong inisize");
@@ -60,9 +86,7 @@ Circom_Circuit* loadCircuit(const void *buffer, unsigned long buffer_size) {
       if (buffer_size <= inisize) {
           throw std::runtime_error("Invalid circuit file: buffer_size <= inisize");
       }
-      u32 dataiomap[(buffer_size-inisize)/sizeof(u32)];
-      memcpy((void *)dataiomap, (void *)(bdata+inisize), buffer_size-inisize);
-      u32* pu32 = dataiomap;
+      u32* pu32 = (u32*)(bdata+inisize);
 
       for (int i = 0; i < get_size_of_io_map(); i++) {
         u32 n = *pu32;
@@ -87,107 +111,7 @@ Circom_Circuit* loadCircuit(const void *buffer, unsigned long buffer_size) {
     }
     circuit->templateInsId2IOSignalInfo = std::move(templateInsId2IOSignalInfo1);
 
-    return circuit;
-}
-
-bool check_valid_number(std::string & s, uint base){
-  bool is_valid = true;
-  if (base == 16){
-    for (uint i = 0; i < s.size(); i++){
-      is_valid &= (
-        ('0' <= s[i] && s[i] <= '9') ||
-        ('a' <= s[i] && s[i] <= 'f') ||
-        ('A' <= s[i] && s[i] <= 'F')
-      );
-    }
-  } else{
-    for (uint i = 0; i < s.size(); i++){
-      is_valid &= ('0' <= s[i] && s[i] < char(int('0') + base));
-    }
-  }
-  return is_valid;
-}
-
-void json2FrElements (json val, std::vector<FrElement> & vval){
-  if (!val.is_array()) {
-    FrElement v;
-    std::string s_aux, s;
-    uint base;
-    if (val.is_string()) {
-      s_aux = val.get<std::string>();
-      std::string possible_prefix = s_aux.substr(0, 2);
-      if (possible_prefix == "0b" || possible_prefix == "0B"){
-        s = s_aux.substr(2, s_aux.size() - 2);
-        base = 2;
-      } else if (possible_prefix == "0o" || possible_prefix == "0O"){
-        s = s_aux.substr(2, s_aux.size() - 2);
-        base = 8;
-      } else if (possible_prefix == "0x" || possible_prefix == "0X"){
-        s = s_aux.substr(2, s_aux.size() - 2);
-        base = 16;
-      } else{
-        s = s_aux;
-        base = 10;
-      }
-      if (!check_valid_number(s, base)){
-        std::ostringstream errStrStream;
-        errStrStream << "Invalid number in JSON input: " << s_aux << "\n";
-          throw std::runtime_error(errStrStream.str() );
-      }
-    } else if (val.is_number()) {
-        double vd = val.get<double>();
-        std::stringstream stream;
-        stream << std::fixed << std::setprecision(0) << vd;
-        s = stream.str();
-        base = 10;
-    } else {
-        throw std::runtime_error("Invalid JSON type");
-    }
-    Fr_str2element (&v, s.c_str(), base);
-    vval.push_back(v);
-  } else {
-    for (uint i = 0; i < val.size(); i++) {
-      json2FrElements (val[i], vval);
-    }
-  }
-}
-
-void loadJson(Circom_CalcWit *ctx, const char *json_buffer, unsigned long buffer_size) {
-
-  json j = json::parse(json_buffer, json_buffer + buffer_size);
-
-  u64 nItems = j.size();
-  // printf("Items : %llu\n",nItems);
-  if (nItems == 0){
-    ctx->tryRunCircuit();
-  }
-  for (json::iterator it = j.begin(); it != j.end(); ++it) {
-    // std::cout << it.key() << " => " << it.value() << '\n';
-    u64 h = fnv1a(it.key());
-    std::vector<FrElement> v;
-    json2FrElements(it.value(),v);
-    uint signalSize = ctx->getInputSignalSize(h);
-    if (v.size() < signalSize) {
-	std::ostringstream errStrStream;
-	errStrStream << "Error loading signal " << it.key() << ": Not enough values\n";
-	throw std::runtime_error(errStrStream.str() );
-    }
-    if (v.size() > signalSize) {
-	std::ostringstream errStrStream;
-	errStrStream << "Error loading signal " << it.key() << ": Too many values\n";
-	throw std::runtime_error(errStrStream.str() );
-    }
-    for (uint i = 0; i<v.size(); i++){
-      try {
-        // std::cout << it.key() << "," << i << " => " << Fr_element2str(&(v[i])) << '\n';
-        ctx->setInputSignal(h,i,v[i]);
-      } catch (std::runtime_error e) {
-        std::ostringstream errStrStream;
-        errStrStream << "Error setting signal: " << it.key() << "\n" << e.what();
-        throw std::runtime_error(errStrStream.str() );
-      }
-    }
-  }
+    return circuit.release();
 }
 
 unsigned long getBinWitnessSize() {
@@ -218,7 +142,9 @@ char *appendBuffer(char *buffer, const FrRawElement src) {
     return appendBuffer(buffer, src, Fr_N64*8);
 }
 
-void storeBinWitness(Circom_CalcWit *ctx, char *buffer) {
+// With montgomery the data section holds the witness in Montgomery form and
+// has id 3, see witnesscalc_with_circuit_flags().
+void storeBinWitness(Circom_CalcWit *ctx, char *buffer, bool montgomery) {
 
      buffer = appendBuffer(buffer,  "wtns", 4);
 
@@ -247,24 +173,131 @@ void storeBinWitness(Circom_CalcWit *ctx, char *buffer) {
      buffer = appendBuffer(buffer, nVars);
 
      // Data
-     u32 idSection2 = 2;
+     u32 idSection2 = montgomery ? 3 : 2;
      buffer = appendBuffer(buffer, idSection2);
 
      u64 idSection2length = (u64)n8*(u64)Nwtns;
      buffer = appendBuffer(buffer, idSection2length);
 
-     FrElement v;
+     ctx->getWitnessBytes(0, Nwtns, buffer, montgomery);
+}
 
-     for (int i=0;i<Nwtns;i++) {
-         ctx->getWitness(i, &v);
-         Fr_toLongNormal(&v, &v);
-         buffer = appendBuffer(buffer, v.longVal);
-     }
+struct witnesscalc_circuit {
+    std::unique_ptr<FileMapLoader>      dat;        // backs circuit when loaded from a .dat file
+    std::unique_ptr<Circom_Circuit>     circuit;    // immutable once loaded
+    std::unique_ptr<Circom_CalcWitPool> pool;       // per-call state, reused across calls
+    std::unique_ptr<Circom_CalcWitPool> batchPool;  // single threaded contexts for batches
+
+    void setCircuit(Circom_Circuit *aCircuit) {
+        circuit.reset(aCircuit);
+        pool.reset(new Circom_CalcWitPool(aCircuit));
+        // A batch already keeps every core busy with its own item.
+        batchPool.reset(new Circom_CalcWitPool(aCircuit, 1));
+    }
+};
+
+int handleException(char *error_msg, unsigned long error_msg_maxsize)
+{
+    try {
+        throw;
+
+    } catch (std::exception& e) {
+
+        if (error_msg) {
+            strncpy(error_msg, e.what(), error_msg_maxsize);
+        }
+
+    } catch (std::exception *e) {
+
+        if (error_msg) {
+            strncpy(error_msg, e->what(), error_msg_maxsize);
+        }
+        delete e;
+
+    } catch (...) {
+        if (error_msg) {
+            strncpy(error_msg, "unknown error", error_msg_maxsize);
+        }
+    }
+
+    return WITNESSCALC_ERROR;
 }
 
-int witnesscalc(
-    const char *circuit_buffer,  unsigned long  circuit_size,
-    const char *json_buffer,     unsigned long  json_size,
+int witnesscalc_circuit_load(
+    const char          *circuit_buffer,  unsigned long  circuit_size,
+    witnesscalc_circuit **circuit,
+    char                *error_msg,       unsigned long  error_msg_maxsize)
+{
+    try {
+
+        std::unique_ptr<witnesscalc_circuit> handle(new witnesscalc_circuit);
+        handle->setCircuit(loadCircuit(circuit_buffer, circuit_size));
+
+        *circuit = handle.release();
+
+    } catch (...) {
+        return handleException(error_msg, error_msg_maxsize);
+    }
+
+    return WITNESSCALC_OK;
+}
+
+int witnesscalc_circuit_load_from_dat_file(
+    const char          *dat_fname,
+    witnesscalc_circuit **circuit,
+    char                *error_msg,       unsigned long  error_msg_maxsize)
+{
+    try {
+
+        std::unique_ptr<witnesscalc_circuit> handle(new witnesscalc_circuit);
+        handle->dat.reset(new FileMapLoader(dat_fname));
+        handle->setCircuit(loadCircuit(handle->dat->buffer, handle->dat->size, true));
+
+        *circuit = handle.release();
+
+    } catch (...) {
+        return handleException(error_msg, error_msg_maxsize);
+    }
+
+    return WITNESSCALC_OK;
+}
+
+void witnesscalc_circuit_free(witnesscalc_circuit *circuit)
+{
+    delete circuit;
+}
+
+// Assigns every input of ctx from input_buffer, which holds JSON or, with
+// binInput, the binary input format, and so runs the circuit.
+void loadInputs(
+    const witnesscalc_circuit *circuit,
+    Circom_CalcWit *ctx,
+    const char *input_buffer,    unsigned long  input_size,
+    bool        binInput)
+{
+    if (binInput) {
+        loadBinInput(ctx, circuit->circuit.get(), input_buffer, input_size);
+    } else {
+        loadJsonBuffer(ctx, input_buffer, input_size);
+    }
+
+    if (ctx->getRemaingInputsToBeSet() != 0) {
+        std::stringstream stream;
+        stream << "Not all inputs have been set. Only "
+               << get_main_input_signal_no()-ctx->getRemaingInputsToBeSet()
+               << " out of " << get_main_input_signal_no();
+        throw std::runtime_error(stream.str());
+    }
+}
+
+// Runs circuit with a context from pool on inputs read from input_buffer,
+// which holds JSON or, with binInput, the binary input format.
+int calcWitness(
+    const witnesscalc_circuit *circuit,
+    Circom_CalcWitPool *pool,
+    const char *input_buffer,    unsigned long  input_size,
+    bool        binInput,
+    unsigned int wtns_flags,
     char       *wtns_buffer,     unsigned long *wtns_size,
     char       *error_msg,       unsigned long  error_msg_maxsize)
 {
@@ -277,63 +310,475 @@ int witnesscalc(
 
     try {
 
-        std::unique_ptr<Circom_Circuit> circuit(loadCircuit(circuit_buffer, circuit_size));
+        if (wtns_flags & ~WITNESSCALC_WTNS_MONTGOMERY) {
+            throw std::runtime_error("Unknown witness flags");
+        }
 
-        std::unique_ptr<Circom_CalcWit> ctx(new Circom_CalcWit(circuit.get()));
+        // Deletes the context instead of pooling it if the run throws.
+        std::unique_ptr<Circom_CalcWit> ctx(pool->acquire());
 
-        loadJson(ctx.get(), json_buffer, json_size);
+        loadInputs(circuit, ctx.get(), input_buffer, input_size, binInput);
 
-        if (ctx->getRemaingInputsToBeSet() != 0) {
-            std::stringstream stream;
-            stream << "Not all inputs have been set. Only "
-                   << get_main_input_signal_no()-ctx->getRemaingInputsToBeSet()
-                   << " out of " << get_main_input_signal_no();
+        storeBinWitness(ctx.get(), wtns_buffer, wtns_flags & WITNESSCALC_WTNS_MONTGOMERY);
+        *wtns_size = witnessSize;
 
-            strncpy(error_msg, stream.str().c_str(), error_msg_maxsize);
-            return WITNESSCALC_ERROR;
+        pool->release(ctx.release());
+
+    } catch (...) {
+        return handleException(error_msg, error_msg_maxsize);
+    }
+
+    return WITNESSCALC_OK;
+}
+
+// Runs circuit like calcWitness() but only writes the n witnesses in
+// indices, or witnesses 1 to n when indices is NULL, to out_buffer.
+int calcWitnessSelect(
+    const witnesscalc_circuit *circuit,
+    const char *input_buffer,    unsigned long  input_size,
+    bool        binInput,
+    const unsigned long *indices, unsigned long n,
+    char       *out_buffer,      unsigned long *out_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    const unsigned long n8 = Fr_N64*8;
+    unsigned long outSize = n * n8;
+
+    if (*out_size < outSize) {
+        *out_size = outSize;
+        return WITNESSCALC_ERROR_SHORT_BUFFER;
+    }
+
+    try {
+
+        const unsigned long nWitness = get_size_of_witness();
+        for (unsigned long i = 0; i < n; i++) {
+            unsigned long idx = indices ? indices[i] : i + 1;
+            if (idx >= nWitness) {
+                std::stringstream stream;
+                stream << "Witness index " << idx << " out of range, the circuit has "
+                       << nWitness << " witnesses";
+                throw std::runtime_error(stream.str());
+            }
         }
 
-        storeBinWitness(ctx.get(), wtns_buffer);
-        *wtns_size = witnessSize;
+        std::unique_ptr<Circom_CalcWit> ctx(circuit->pool->acquire());
 
-    } catch (std::exception& e) {
+        loadInputs(circuit, ctx.get(), input_buffer, input_size, binInput);
 
-        if (error_msg) {
-            strncpy(error_msg, e.what(), error_msg_maxsize);
+        // Consecutive indices are exported together.
+        for (unsigned long i = 0; i < n; ) {
+            unsigned long first = indices ? indices[i] : i + 1;
+            unsigned long j = i + 1;
+            while (j < n && (!indices || indices[j] == indices[j - 1] + 1)) {
+                j++;
+            }
+            ctx->getWitnessBytes(first, j - i, out_buffer + i * n8);
+            i = j;
         }
-        return WITNESSCALC_ERROR;
+        *out_size = outSize;
 
-    } catch (std::exception *e) {
+        circuit->pool->release(ctx.release());
 
-        if (error_msg) {
-            strncpy(error_msg, e->what(), error_msg_maxsize);
+    } catch (...) {
+        return handleException(error_msg, error_msg_maxsize);
+    }
+
+    return WITNESSCALC_OK;
+}
+
+int witnesscalc_with_circuit(
+    const witnesscalc_circuit *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return calcWitness(circuit, circuit->pool.get(), json_buffer, json_size, false,
+                       WITNESSCALC_WTNS_NORMAL,
+                       wtns_buffer, wtns_size,
+                       error_msg, error_msg_maxsize);
+}
+
+int witnesscalc_with_circuit_flags(
+    const witnesscalc_circuit *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    unsigned int wtns_flags,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return calcWitness(circuit, circuit->pool.get(), json_buffer, json_size, false,
+                       wtns_flags,
+                       wtns_buffer, wtns_size,
+                       error_msg, error_msg_maxsize);
+}
+
+// Runs the items of a batch on n_threads threads. Inputs are JSON or, with
+// binInput, in the binary input format.
+int calcWitnessBatch(
+    const witnesscalc_circuit *circuit,
+    unsigned long        n_inputs,
+    const char * const  *input_buffers, const unsigned long *input_sizes,
+    bool                 binInput,
+    char * const        *wtns_buffers,  unsigned long       *wtns_sizes,
+    int                 *results,
+    char * const        *error_msgs,    unsigned long        error_msg_maxsize,
+    unsigned int         n_threads)
+{
+    if (n_threads == 0) {
+        n_threads = std::thread::hardware_concurrency();
+    }
+    if (n_threads == 0) {
+        n_threads = 1;
+    }
+    if (n_threads > n_inputs) {
+        n_threads = n_inputs;
+    }
+
+    std::atomic<unsigned long> next(0);
+
+    auto worker = [&]() {
+        for (unsigned long i = next++; i < n_inputs; i = next++) {
+            results[i] = calcWitness(circuit, circuit->batchPool.get(),
+                                     input_buffers[i], input_sizes[i], binInput,
+                                     WITNESSCALC_WTNS_NORMAL,
+                                     wtns_buffers[i], &wtns_sizes[i],
+                                     error_msgs[i],   error_msg_maxsize);
         }
-        delete e;
-        return WITNESSCALC_ERROR;
+    };
 
+    std::vector<std::thread> threads;
+    try {
+        for (unsigned int i = 1; i < n_threads; i++) {
+            threads.emplace_back(worker);
+        }
     } catch (...) {
-        if (error_msg) {
-            strncpy(error_msg, "unknown error", error_msg_maxsize);
+        // Out of threads: the ones already running share the remaining items.
+    }
+
+    worker();
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    for (unsigned long i = 0; i < n_inputs; i++) {
+        if (results[i] != WITNESSCALC_OK) {
+            return WITNESSCALC_ERROR;
         }
-        return WITNESSCALC_ERROR;
     }
 
     return WITNESSCALC_OK;
 }
 
+int witnesscalc_batch(
+    const witnesscalc_circuit *circuit,
+    unsigned long        n_inputs,
+    const char * const  *json_buffers,  const unsigned long *json_sizes,
+    char * const        *wtns_buffers,  unsigned long       *wtns_sizes,
+    int                 *results,
+    char * const        *error_msgs,    unsigned long        error_msg_maxsize,
+    unsigned int         n_threads)
+{
+    return calcWitnessBatch(circuit, n_inputs,
+                            json_buffers, json_sizes, false,
+                            wtns_buffers, wtns_sizes,
+                            results,
+                            error_msgs,   error_msg_maxsize,
+                            n_threads);
+}
+
+int witnesscalc(
+    const char *circuit_buffer,  unsigned long  circuit_size,
+    const char *json_buffer,     unsigned long  json_size,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    unsigned long witnessSize = getBinWitnessSize();
+
+    if (*wtns_size < witnessSize) {
+        *wtns_size = witnessSize;
+        return WITNESSCALC_ERROR_SHORT_BUFFER;
+    }
+
+    witnesscalc_circuit circuit;
+
+    try {
+
+        // circuit_buffer outlives the call, so run straight out of it.
+        circuit.setCircuit(loadCircuit(circuit_buffer, circuit_size, true));
+
+    } catch (...) {
+        return handleException(error_msg, error_msg_maxsize);
+    }
+
+    return witnesscalc_with_circuit(&circuit, json_buffer, json_size,
+                                    wtns_buffer, wtns_size,
+                                    error_msg, error_msg_maxsize);
+}
+
 int witnesscalc_from_dat_file(
         const char *dat_fname,
         const char *json_buffer,     unsigned long  json_size,
         char       *wtns_buffer,     unsigned long *wtns_size,
         char       *error_msg,       unsigned long  error_msg_maxsize)
 {
+    witnesscalc_circuit *circuit = NULL;
 
-    std::string s(dat_fname);
-    FileMapLoader dat(dat_fname);
-    return witnesscalc(dat.buffer, dat.size, json_buffer,
-                       json_size, wtns_buffer, wtns_size,
+    int error = witnesscalc_circuit_load_from_dat_file(dat_fname, &circuit,
+                                                       error_msg, error_msg_maxsize);
+    if (error) {
+        return error;
+    }
+
+    error = witnesscalc_with_circuit(circuit, json_buffer, json_size,
+                                     wtns_buffer, wtns_size,
+                                     error_msg, error_msg_maxsize);
+
+    witnesscalc_circuit_free(circuit);
+
+    return error;
+}
+
+int witnesscalc_bin_with_circuit(
+    const witnesscalc_circuit *circuit,
+    const char *bin_buffer,      unsigned long  bin_size,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return calcWitness(circuit, circuit->pool.get(), bin_buffer, bin_size, true,
+                       WITNESSCALC_WTNS_NORMAL,
+                       wtns_buffer, wtns_size,
                        error_msg, error_msg_maxsize);
 }
 
+int witnesscalc_bin_with_circuit_flags(
+    const witnesscalc_circuit *circuit,
+    const char *bin_buffer,      unsigned long  bin_size,
+    unsigned int wtns_flags,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return calcWitness(circuit, circuit->pool.get(), bin_buffer, bin_size, true,
+                       wtns_flags,
+                       wtns_buffer, wtns_size,
+                       error_msg, error_msg_maxsize);
+}
+
+int witnesscalc_bin(
+    const char *circuit_buffer,  unsigned long  circuit_size,
+    const char *bin_buffer,      unsigned long  bin_size,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    unsigned long witnessSize = getBinWitnessSize();
+
+    if (*wtns_size < witnessSize) {
+        *wtns_size = witnessSize;
+        return WITNESSCALC_ERROR_SHORT_BUFFER;
+    }
+
+    witnesscalc_circuit circuit;
+
+    try {
+
+        circuit.setCircuit(loadCircuit(circuit_buffer, circuit_size, true));
+
+    } catch (...) {
+        return handleException(error_msg, error_msg_maxsize);
+    }
+
+    return witnesscalc_bin_with_circuit(&circuit, bin_buffer, bin_size,
+                                        wtns_buffer, wtns_size,
+                                        error_msg, error_msg_maxsize);
+}
+
+int witnesscalc_select_with_circuit(
+    const witnesscalc_circuit *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    const unsigned long *indices, unsigned long n_indices,
+    char       *out_buffer,      unsigned long *out_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return calcWitnessSelect(circuit, json_buffer, json_size, false,
+                             indices, n_indices,
+                             out_buffer, out_size,
+                             error_msg, error_msg_maxsize);
+}
+
+int witnesscalc_bin_select_with_circuit(
+    const witnesscalc_circuit *circuit,
+    const char *bin_buffer,      unsigned long  bin_size,
+    const unsigned long *indices, unsigned long n_indices,
+    char       *out_buffer,      unsigned long *out_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return calcWitnessSelect(circuit, bin_buffer, bin_size, true,
+                             indices, n_indices,
+                             out_buffer, out_size,
+                             error_msg, error_msg_maxsize);
+}
+
+int witnesscalc_bin_batch(
+    const witnesscalc_circuit *circuit,
+    unsigned long        n_inputs,
+    const char * const  *bin_buffers,   const unsigned long *bin_sizes,
+    char * const        *wtns_buffers,  unsigned long       *wtns_sizes,
+    int                 *results,
+    char * const        *error_msgs,    unsigned long        error_msg_maxsize,
+    unsigned int         n_threads)
+{
+    return calcWitnessBatch(circuit, n_inputs,
+                            bin_buffers,  bin_sizes, true,
+                            wtns_buffers, wtns_sizes,
+                            results,
+                            error_msgs,   error_msg_maxsize,
+                            n_threads);
+}
+
+int witnesscalc_json_to_bin(
+    const witnesscalc_circuit *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    unsigned int flags,
+    char       *bin_buffer,      unsigned long *bin_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    unsigned long binSize = getBinInputSize();
+
+    if (*bin_size < binSize) {
+        *bin_size = binSize;
+        return WITNESSCALC_ERROR_SHORT_BUFFER;
+    }
+
+    try {
+
+        if (flags & ~WITNESSCALC_BIN_MONTGOMERY) {
+            throw std::runtime_error("Unknown binary input flags");
+        }
+
+        uint n = get_main_input_signal_no();
+        std::vector<FrElement> inputs(n);
+
+        // The context only resolves signal names: nothing is assigned.
+        std::unique_ptr<Circom_CalcWit> ctx(circuit->pool->acquire());
+        u64 nStored = parseJsonBuffer(ctx.get(), json_buffer, json_size, inputs.data());
+        circuit->pool->release(ctx.release());
+
+        if (nStored != n) {
+            std::stringstream stream;
+            stream << "Not all inputs have been set. Only "
+                   << nStored << " out of " << n;
+            throw std::runtime_error(stream.str());
+        }
+
+        storeBinInput(circuit->circuit.get(), inputs.data(), flags, bin_buffer);
+        *bin_size = binSize;
+
+    } catch (...) {
+        return handleException(error_msg, error_msg_maxsize);
+    }
+
+    return WITNESSCALC_OK;
+}
+
+int witnesscalc_input_slot_resolve(
+    const witnesscalc_circuit *circuit,
+    const char *name,
+    witnesscalc_input_slot *slot,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    try {
+
+        uint pos;
+        if (!Circom_findInput(circuit->circuit.get(), fnv1a(name), pos)) {
+            throw std::runtime_error(std::string("No input ") + name + " in the circuit");
+        }
+
+        const HashSignalInfo &info = circuit->circuit->InputHashMap[pos];
+        slot->index = info.signalid - get_main_input_signal_start();
+        slot->size = info.signalsize;
+
+    } catch (...) {
+        return handleException(error_msg, error_msg_maxsize);
+    }
+
+    return WITNESSCALC_OK;
+}
+
+int witnesscalc_bin_header(
+    const witnesscalc_circuit *circuit,
+    unsigned int flags,
+    char       *bin_buffer,      unsigned long *bin_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    unsigned long binSize = getBinInputSize();
+
+    if (*bin_size < binSize) {
+        *bin_size = binSize;
+        return WITNESSCALC_ERROR_SHORT_BUFFER;
+    }
+
+    try {
+
+        if (flags & ~WITNESSCALC_BIN_MONTGOMERY) {
+            throw std::runtime_error("Unknown binary input flags");
+        }
+
+        storeBinInputHeader(circuit->circuit.get(), flags, bin_buffer);
+        *bin_size = binSize;
+
+    } catch (...) {
+        return handleException(error_msg, error_msg_maxsize);
+    }
+
+    return WITNESSCALC_OK;
+}
+
+int witnesscalc_input_schema(
+    const witnesscalc_circuit *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    char       *schema_buffer,   unsigned long *schema_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    try {
+
+        std::vector<FrElement> inputs(get_main_input_signal_no());
+        std::vector<JsonInputShape> shapes;
+
+        std::unique_ptr<Circom_CalcWit> ctx(circuit->pool->acquire());
+        parseJsonBuffer(ctx.get(), json_buffer, json_size, inputs.data(), &shapes);
+        circuit->pool->release(ctx.release());
+
+        std::string schema = formatInputSchema(circuit->circuit.get(), shapes);
+
+        if (*schema_size < schema.size()) {
+            *schema_size = schema.size();
+            return WITNESSCALC_ERROR_SHORT_BUFFER;
+        }
+
+        memcpy(schema_buffer, schema.data(), schema.size());
+        *schema_size = schema.size();
+
+    } catch (...) {
+        return handleException(error_msg, error_msg_maxsize);
+    }
+
+    return WITNESSCALC_OK;
+}
+
+int witnesscalc_input_schema_check(
+    const witnesscalc_circuit *circuit,
+    const char *schema_buffer,   unsigned long  schema_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    try {
+
+        loadInputSchema(circuit->circuit.get(), schema_buffer, schema_size);
+
+    } catch (...) {
+        return handleException(error_msg, error_msg_maxsize);
+    }
+
+    return WITNESSCALC_OK;
+}
 
 } // namespace
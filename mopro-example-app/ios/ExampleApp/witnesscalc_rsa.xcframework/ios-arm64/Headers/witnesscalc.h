@@ -7,6 +7,18 @@ namespace CIRCUIT_NAME {
 #define WITNESSCALC_ERROR               0x1
 #define WITNESSCALC_ERROR_SHORT_BUFFER  0x2
 
+/**
+ * Flags of the binary input format, see `witnesscalc_bin`.
+ */
+#define WITNESSCALC_BIN_NORMAL          0x0
+#define WITNESSCALC_BIN_MONTGOMERY      0x1
+
+/**
+ * Flags of the witness output, see `witnesscalc_with_circuit_flags`.
+ */
+#define WITNESSCALC_WTNS_NORMAL         0x0
+#define WITNESSCALC_WTNS_MONTGOMERY     0x1
+
 /**
  *
  * @return error code:
@@ -39,6 +51,281 @@ witnesscalc_from_dat_file(
     char       *wtns_buffer,     unsigned long *wtns_size,
     char       *error_msg,       unsigned long  error_msg_maxsize);
 
+/**
+ * A circuit loaded once and shared by any number of witness computations,
+ * including concurrent ones: it is immutable after loading and every
+ * witnesscalc_with_circuit call keeps its own state.
+ */
+struct witnesscalc_circuit;
+
+/**
+ * Parses the circuit in circuit_buffer, which is copied, so the buffer can be
+ * released once the function returns.
+ *
+ * @return error code:
+ *         WITNESSCALC_OK - in case of success.
+ *         WITNESSCALC_ERROR - in case of an error.
+ *
+ * On success circuit receives a handle that must be released with
+ * witnesscalc_circuit_free.
+ */
+int
+witnesscalc_circuit_load(
+    const char          *circuit_buffer,  unsigned long  circuit_size,
+    witnesscalc_circuit **circuit,
+    char                *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Same as `witnesscalc_circuit_load` but maps the .dat file read-only and
+ * runs straight out of the mapping, which is kept until the circuit is freed.
+ */
+int
+witnesscalc_circuit_load_from_dat_file(
+    const char          *dat_fname,
+    witnesscalc_circuit **circuit,
+    char                *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Computes a witness for a circuit returned by `witnesscalc_circuit_load`.
+ * Takes the same arguments and returns the same error codes as `witnesscalc`.
+ */
+int
+witnesscalc_with_circuit(
+    const witnesscalc_circuit *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Same as `witnesscalc_with_circuit` with the form of the witness given by
+ * wtns_flags. With WITNESSCALC_WTNS_NORMAL the output is a standard .wtns
+ * file. With WITNESSCALC_WTNS_MONTGOMERY every witness is stored in
+ * Montgomery form, a * 2^256 mod q, so a prover that works in that form can
+ * use it without converting it back. Its data section then has id 3 instead
+ * of 2, with the same length, so readers that only know the standard format
+ * reject it rather than read wrong values. The header section is unchanged.
+ */
+int
+witnesscalc_with_circuit_flags(
+    const witnesscalc_circuit *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    unsigned int wtns_flags,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Computes the witnesses of n_inputs inputs of the same circuit on n_threads
+ * threads, each with its own context (0 means one thread per core).
+ *
+ * Item i reads json_buffers[i] and writes its witness to wtns_buffers[i],
+ * whose size is passed in and returned in wtns_sizes[i] like in
+ * `witnesscalc`. Its error code is stored in results[i] and, on error, its
+ * message in error_msgs[i], which holds error_msg_maxsize bytes.
+ *
+ * @return error code:
+ *         WITNESSCALC_OK - if every item succeeded.
+ *         WITNESSCALC_ERROR - if any item failed, see results.
+ */
+int
+witnesscalc_batch(
+    const witnesscalc_circuit *circuit,
+    unsigned long        n_inputs,
+    const char * const  *json_buffers,  const unsigned long *json_sizes,
+    char * const        *wtns_buffers,  unsigned long       *wtns_sizes,
+    int                 *results,
+    char * const        *error_msgs,    unsigned long        error_msg_maxsize,
+    unsigned int         n_threads);
+
+void
+witnesscalc_circuit_free(witnesscalc_circuit *circuit);
+
+/**
+ * Same as `witnesscalc` but reads the inputs from bin_buffer in the binary
+ * input format instead of JSON, which skips parsing them altogether:
+ *
+ *   a 32 byte header: "winp", u32 version 1, u32 bytes per element (32),
+ *   u32 flags (WITNESSCALC_BIN_NORMAL or WITNESSCALC_BIN_MONTGOMERY),
+ *   u64 fingerprint of the circuit inputs, u32 number of input signals and
+ *   u32 0, all little-endian,
+ *
+ *   followed by every input signal in signal order, each one a little-endian
+ *   element smaller than the field modulus, in normal or Montgomery form.
+ *
+ * Inputs are rejected with WITNESSCALC_ERROR if the fingerprint is not the
+ * circuit's. `witnesscalc_json_to_bin` produces them from JSON.
+ */
+int
+witnesscalc_bin(
+    const char *circuit_buffer,  unsigned long  circuit_size,
+    const char *bin_buffer,      unsigned long  bin_size,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Same as `witnesscalc_bin` for a circuit returned by
+ * `witnesscalc_circuit_load`.
+ */
+int
+witnesscalc_bin_with_circuit(
+    const witnesscalc_circuit *circuit,
+    const char *bin_buffer,      unsigned long  bin_size,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Same as `witnesscalc_batch` for inputs in the binary input format of
+ * `witnesscalc_bin`: item i reads bin_buffers[i].
+ */
+int
+witnesscalc_bin_batch(
+    const witnesscalc_circuit *circuit,
+    unsigned long        n_inputs,
+    const char * const  *bin_buffers,   const unsigned long *bin_sizes,
+    char * const        *wtns_buffers,  unsigned long       *wtns_sizes,
+    int                 *results,
+    char * const        *error_msgs,    unsigned long        error_msg_maxsize,
+    unsigned int         n_threads);
+
+/**
+ * Same as `witnesscalc_bin_with_circuit` with the form of the witness given
+ * by wtns_flags, as in `witnesscalc_with_circuit_flags`.
+ */
+int
+witnesscalc_bin_with_circuit_flags(
+    const witnesscalc_circuit *circuit,
+    const char *bin_buffer,      unsigned long  bin_size,
+    unsigned int wtns_flags,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Runs the circuit like `witnesscalc_with_circuit` but only returns the
+ * witnesses listed in indices, for callers that need a few values, such as
+ * the outputs and public signals, and not a whole .wtns file.
+ *
+ * out_buffer receives n_indices little-endian elements of 32 bytes in normal
+ * form, in the order of indices, without any header. If indices is NULL the
+ * witnesses are 1 to n_indices, which are the n_indices public signals of
+ * the circuit (outputs first, then public inputs) when n_indices is their
+ * number, in the order of a snarkjs public.json.
+ *
+ * @return error code:
+ *         WITNESSCALC_OK - in case of success.
+ *         WITNESSCALC_ERROR - in case of an error, such as an index that is
+ *         not smaller than the number of witnesses.
+ *         WITNESSCALC_ERROR_SHORT_BUFFER - if out_buffer is too small, in
+ *         which case out_size receives the size it needs. The circuit
+ *         does not run then.
+ */
+int
+witnesscalc_select_with_circuit(
+    const witnesscalc_circuit *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    const unsigned long *indices, unsigned long n_indices,
+    char       *out_buffer,      unsigned long *out_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Same as `witnesscalc_select_with_circuit` for inputs in the binary input
+ * format of `witnesscalc_bin`.
+ */
+int
+witnesscalc_bin_select_with_circuit(
+    const witnesscalc_circuit *circuit,
+    const char *bin_buffer,      unsigned long  bin_size,
+    const unsigned long *indices, unsigned long n_indices,
+    char       *out_buffer,      unsigned long *out_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Converts the JSON inputs in json_buffer to the binary input format of
+ * `witnesscalc_bin`, with elements in the form given by flags. The circuit
+ * does not run.
+ *
+ * @return error code:
+ *         WITNESSCALC_OK - in case of success.
+ *         WITNESSCALC_ERROR - in case of an error.
+ *         WITNESSCALC_ERROR_SHORT_BUFFER - if bin_buffer is too small, in
+ *         which case bin_size receives the size it needs.
+ */
+int
+witnesscalc_json_to_bin(
+    const witnesscalc_circuit *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    unsigned int flags,
+    char       *bin_buffer,      unsigned long *bin_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * A main input resolved by name: its signals are elements index to
+ * index+size-1 of the binary input format.
+ */
+struct witnesscalc_input_slot {
+    unsigned long index;
+    unsigned long size;
+};
+
+/**
+ * Resolves the input called name once, so requests can then be filled with
+ * direct writes: element i of the input goes to
+ * bin_buffer + 32 + (slot.index + i) * 32 of a buffer started with
+ * `witnesscalc_bin_header`.
+ *
+ * @return error code:
+ *         WITNESSCALC_OK - in case of success.
+ *         WITNESSCALC_ERROR - if the circuit has no such input.
+ */
+int
+witnesscalc_input_slot_resolve(
+    const witnesscalc_circuit *circuit,
+    const char *name,
+    witnesscalc_input_slot *slot,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Writes the header of the binary input format for circuit at the start of
+ * bin_buffer, which must hold a whole input. bin_size returns its size, or
+ * the size needed with WITNESSCALC_ERROR_SHORT_BUFFER.
+ */
+int
+witnesscalc_bin_header(
+    const witnesscalc_circuit *circuit,
+    unsigned int flags,
+    char       *bin_buffer,      unsigned long *bin_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Produces the input schema of circuit, a text file meant to be shipped next
+ * to the .dat, from a complete example input in json_buffer, whose array
+ * nesting gives the dimensions of every input. Each line holds the name,
+ * index and size of an input, as in `witnesscalc_input_slot`, followed by
+ * its dimensions, after a header line with the fingerprint of the circuit.
+ *
+ * schema_size returns the length of the text, or the size needed with
+ * WITNESSCALC_ERROR_SHORT_BUFFER.
+ */
+int
+witnesscalc_input_schema(
+    const witnesscalc_circuit *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    char       *schema_buffer,   unsigned long *schema_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Checks a schema written by `witnesscalc_input_schema` against circuit,
+ * typically once at startup, so that a .dat and schema that do not belong
+ * together are reported before any request.
+ *
+ * @return error code:
+ *         WITNESSCALC_OK - if every input of the schema matches.
+ *         WITNESSCALC_ERROR - otherwise, with the first mismatch in error_msg.
+ */
+int
+witnesscalc_input_schema_check(
+    const witnesscalc_circuit *circuit,
+    const char *schema_buffer,   unsigned long  schema_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
 } // namespace
 
 #endif // WITNESSCALC_H
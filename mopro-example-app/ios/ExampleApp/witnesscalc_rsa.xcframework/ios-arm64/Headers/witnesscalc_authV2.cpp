@@ -13,3 +13,235 @@ witnesscalc_authV2(
                        wtns_buffer,   wtns_size,
                        error_msg,     error_msg_maxsize);
 }
+
+int
+witnesscalc_authV2_circuit_load(
+    const char *circuit_buffer,  unsigned long  circuit_size,
+    void      **circuit,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return CIRCUIT_NAME::witnesscalc_circuit_load(circuit_buffer, circuit_size,
+                       (CIRCUIT_NAME::witnesscalc_circuit **)circuit,
+                       error_msg,     error_msg_maxsize);
+}
+
+int
+witnesscalc_authV2_with_circuit(
+    void       *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return CIRCUIT_NAME::witnesscalc_with_circuit(
+                       (CIRCUIT_NAME::witnesscalc_circuit *)circuit,
+                       json_buffer,   json_size,
+                       wtns_buffer,   wtns_size,
+                       error_msg,     error_msg_maxsize);
+}
+
+int
+witnesscalc_authV2_with_circuit_flags(
+    void       *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    unsigned int wtns_flags,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return CIRCUIT_NAME::witnesscalc_with_circuit_flags(
+                       (CIRCUIT_NAME::witnesscalc_circuit *)circuit,
+                       json_buffer,   json_size,
+                       wtns_flags,
+                       wtns_buffer,   wtns_size,
+                       error_msg,     error_msg_maxsize);
+}
+
+int
+witnesscalc_authV2_batch(
+    void                *circuit,
+    unsigned long        n_inputs,
+    const char * const  *json_buffers,  const unsigned long *json_sizes,
+    char * const        *wtns_buffers,  unsigned long       *wtns_sizes,
+    int                 *results,
+    char * const        *error_msgs,    unsigned long        error_msg_maxsize,
+    unsigned int         n_threads)
+{
+    return CIRCUIT_NAME::witnesscalc_batch(
+                       (CIRCUIT_NAME::witnesscalc_circuit *)circuit,
+                       n_inputs,
+                       json_buffers,  json_sizes,
+                       wtns_buffers,  wtns_sizes,
+                       results,
+                       error_msgs,    error_msg_maxsize,
+                       n_threads);
+}
+
+void
+witnesscalc_authV2_circuit_free(void *circuit)
+{
+    CIRCUIT_NAME::witnesscalc_circuit_free((CIRCUIT_NAME::witnesscalc_circuit *)circuit);
+}
+
+int
+witnesscalc_authV2_bin(
+    const char *circuit_buffer,  unsigned long  circuit_size,
+    const char *bin_buffer,      unsigned long  bin_size,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return CIRCUIT_NAME::witnesscalc_bin(circuit_buffer, circuit_size,
+                       bin_buffer,    bin_size,
+                       wtns_buffer,   wtns_size,
+                       error_msg,     error_msg_maxsize);
+}
+
+int
+witnesscalc_authV2_bin_with_circuit(
+    void       *circuit,
+    const char *bin_buffer,      unsigned long  bin_size,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return CIRCUIT_NAME::witnesscalc_bin_with_circuit(
+                       (CIRCUIT_NAME::witnesscalc_circuit *)circuit,
+                       bin_buffer,    bin_size,
+                       wtns_buffer,   wtns_size,
+                       error_msg,     error_msg_maxsize);
+}
+
+int
+witnesscalc_authV2_bin_batch(
+    void                *circuit,
+    unsigned long        n_inputs,
+    const char * const  *bin_buffers,   const unsigned long *bin_sizes,
+    char * const        *wtns_buffers,  unsigned long       *wtns_sizes,
+    int                 *results,
+    char * const        *error_msgs,    unsigned long        error_msg_maxsize,
+    unsigned int         n_threads)
+{
+    return CIRCUIT_NAME::witnesscalc_bin_batch(
+                       (CIRCUIT_NAME::witnesscalc_circuit *)circuit,
+                       n_inputs,
+                       bin_buffers,   bin_sizes,
+                       wtns_buffers,  wtns_sizes,
+                       results,
+                       error_msgs,    error_msg_maxsize,
+                       n_threads);
+}
+
+int
+witnesscalc_authV2_bin_with_circuit_flags(
+    void       *circuit,
+    const char *bin_buffer,      unsigned long  bin_size,
+    unsigned int wtns_flags,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return CIRCUIT_NAME::witnesscalc_bin_with_circuit_flags(
+                       (CIRCUIT_NAME::witnesscalc_circuit *)circuit,
+                       bin_buffer,    bin_size,
+                       wtns_flags,
+                       wtns_buffer,   wtns_size,
+                       error_msg,     error_msg_maxsize);
+}
+
+int
+witnesscalc_authV2_select_with_circuit(
+    void       *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    const unsigned long *indices, unsigned long n_indices,
+    char       *out_buffer,      unsigned long *out_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return CIRCUIT_NAME::witnesscalc_select_with_circuit(
+                       (CIRCUIT_NAME::witnesscalc_circuit *)circuit,
+                       json_buffer,   json_size,
+                       indices,       n_indices,
+                       out_buffer,    out_size,
+                       error_msg,     error_msg_maxsize);
+}
+
+int
+witnesscalc_authV2_bin_select_with_circuit(
+    void       *circuit,
+    const char *bin_buffer,      unsigned long  bin_size,
+    const unsigned long *indices, unsigned long n_indices,
+    char       *out_buffer,      unsigned long *out_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return CIRCUIT_NAME::witnesscalc_bin_select_with_circuit(
+                       (CIRCUIT_NAME::witnesscalc_circuit *)circuit,
+                       bin_buffer,    bin_size,
+                       indices,       n_indices,
+                       out_buffer,    out_size,
+                       error_msg,     error_msg_maxsize);
+}
+
+int
+witnesscalc_authV2_json_to_bin(
+    void       *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    unsigned int flags,
+    char       *bin_buffer,      unsigned long *bin_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return CIRCUIT_NAME::witnesscalc_json_to_bin(
+                       (CIRCUIT_NAME::witnesscalc_circuit *)circuit,
+                       json_buffer,   json_size,
+                       flags,
+                       bin_buffer,    bin_size,
+                       error_msg,     error_msg_maxsize);
+}
+
+int
+witnesscalc_authV2_input_slot_resolve(
+    void       *circuit,
+    const char *name,
+    witnesscalc_authV2_input_slot *slot,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return CIRCUIT_NAME::witnesscalc_input_slot_resolve(
+                       (CIRCUIT_NAME::witnesscalc_circuit *)circuit,
+                       name,
+                       (CIRCUIT_NAME::witnesscalc_input_slot *)slot,
+                       error_msg,     error_msg_maxsize);
+}
+
+int
+witnesscalc_authV2_bin_header(
+    void       *circuit,
+    unsigned int flags,
+    char       *bin_buffer,      unsigned long *bin_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return CIRCUIT_NAME::witnesscalc_bin_header(
+                       (CIRCUIT_NAME::witnesscalc_circuit *)circuit,
+                       flags,
+                       bin_buffer,    bin_size,
+                       error_msg,     error_msg_maxsize);
+}
+
+int
+witnesscalc_authV2_input_schema(
+    void       *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    char       *schema_buffer,   unsigned long *schema_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return CIRCUIT_NAME::witnesscalc_input_schema(
+                       (CIRCUIT_NAME::witnesscalc_circuit *)circuit,
+                       json_buffer,   json_size,
+                       schema_buffer, schema_size,
+                       error_msg,     error_msg_maxsize);
+}
+
+int
+witnesscalc_authV2_input_schema_check(
+    void       *circuit,
+    const char *schema_buffer,   unsigned long  schema_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize)
+{
+    return CIRCUIT_NAME::witnesscalc_input_schema_check(
+                       (CIRCUIT_NAME::witnesscalc_circuit *)circuit,
+                       schema_buffer, schema_size,
+                       error_msg,     error_msg_maxsize);
+}
@@ -10,6 +10,12 @@ extern "C" {
 #define WITNESSCALC_ERROR               0x1
 #define WITNESSCALC_ERROR_SHORT_BUFFER  0x2
 
+#define WITNESSCALC_BIN_NORMAL          0x0
+#define WITNESSCALC_BIN_MONTGOMERY      0x1
+
+#define WITNESSCALC_WTNS_NORMAL         0x0
+#define WITNESSCALC_WTNS_MONTGOMERY     0x1
+
 /**
  *
  * @return error code:
@@ -31,6 +37,193 @@ witnesscalc_authV2(
     char       *wtns_buffer,     unsigned long *wtns_size,
     char       *error_msg,       unsigned long  error_msg_maxsize);
 
+/**
+ * Loads the circuit once for use with witnesscalc_authV2_with_circuit.
+ * circuit_buffer is copied. On success circuit receives a handle that
+ * must be released with witnesscalc_authV2_circuit_free.
+ */
+int
+witnesscalc_authV2_circuit_load(
+    const char *circuit_buffer,  unsigned long  circuit_size,
+    void      **circuit,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Same as witnesscalc_authV2 but reuses a circuit loaded with
+ * witnesscalc_authV2_circuit_load. Safe to call concurrently.
+ */
+int
+witnesscalc_authV2_with_circuit(
+    void       *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Same as witnesscalc_authV2_with_circuit but writes the witness in the form
+ * given by wtns_flags, see witnesscalc_with_circuit_flags in witnesscalc.h.
+ */
+int
+witnesscalc_authV2_with_circuit_flags(
+    void       *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    unsigned int wtns_flags,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Computes the witnesses of n_inputs JSON inputs on n_threads threads
+ * (0 means one per core) with a circuit loaded with
+ * witnesscalc_authV2_circuit_load. Every item gets its own error code in
+ * results and error message in error_msgs.
+ */
+int
+witnesscalc_authV2_batch(
+    void                *circuit,
+    unsigned long        n_inputs,
+    const char * const  *json_buffers,  const unsigned long *json_sizes,
+    char * const        *wtns_buffers,  unsigned long       *wtns_sizes,
+    int                 *results,
+    char * const        *error_msgs,    unsigned long        error_msg_maxsize,
+    unsigned int         n_threads);
+
+void
+witnesscalc_authV2_circuit_free(void *circuit);
+
+/**
+ * Same as witnesscalc_authV2 but reads the inputs in the binary input format
+ * described in witnesscalc.h instead of JSON.
+ */
+int
+witnesscalc_authV2_bin(
+    const char *circuit_buffer,  unsigned long  circuit_size,
+    const char *bin_buffer,      unsigned long  bin_size,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Same as witnesscalc_authV2_bin but reuses a circuit loaded with
+ * witnesscalc_authV2_circuit_load. Safe to call concurrently.
+ */
+int
+witnesscalc_authV2_bin_with_circuit(
+    void       *circuit,
+    const char *bin_buffer,      unsigned long  bin_size,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Same as witnesscalc_authV2_batch for inputs in the binary input format.
+ */
+int
+witnesscalc_authV2_bin_batch(
+    void                *circuit,
+    unsigned long        n_inputs,
+    const char * const  *bin_buffers,   const unsigned long *bin_sizes,
+    char * const        *wtns_buffers,  unsigned long       *wtns_sizes,
+    int                 *results,
+    char * const        *error_msgs,    unsigned long        error_msg_maxsize,
+    unsigned int         n_threads);
+
+/**
+ * Same as witnesscalc_authV2_bin_with_circuit but writes the witness in the
+ * form given by wtns_flags.
+ */
+int
+witnesscalc_authV2_bin_with_circuit_flags(
+    void       *circuit,
+    const char *bin_buffer,      unsigned long  bin_size,
+    unsigned int wtns_flags,
+    char       *wtns_buffer,     unsigned long *wtns_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Runs the circuit but only returns the witnesses listed in indices, as
+ * 32 byte elements in normal form, or witnesses 1 to n_indices, the public
+ * signals, when indices is NULL. See witnesscalc_select_with_circuit in
+ * witnesscalc.h.
+ */
+int
+witnesscalc_authV2_select_with_circuit(
+    void       *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    const unsigned long *indices, unsigned long n_indices,
+    char       *out_buffer,      unsigned long *out_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Same as witnesscalc_authV2_select_with_circuit for inputs in the binary
+ * input format.
+ */
+int
+witnesscalc_authV2_bin_select_with_circuit(
+    void       *circuit,
+    const char *bin_buffer,      unsigned long  bin_size,
+    const unsigned long *indices, unsigned long n_indices,
+    char       *out_buffer,      unsigned long *out_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Converts JSON inputs to the binary input format, with elements in normal
+ * or Montgomery form as given by flags, without running the circuit.
+ */
+int
+witnesscalc_authV2_json_to_bin(
+    void       *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    unsigned int flags,
+    char       *bin_buffer,      unsigned long *bin_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * An input resolved by name, see witnesscalc_input_slot in witnesscalc.h.
+ */
+typedef struct {
+    unsigned long index;
+    unsigned long size;
+} witnesscalc_authV2_input_slot;
+
+/**
+ * Resolves the input called name once, for direct writes into buffers
+ * started with witnesscalc_authV2_bin_header.
+ */
+int
+witnesscalc_authV2_input_slot_resolve(
+    void       *circuit,
+    const char *name,
+    witnesscalc_authV2_input_slot *slot,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Writes the header of a binary input at the start of bin_buffer, which
+ * must hold a whole input, and its size to bin_size.
+ */
+int
+witnesscalc_authV2_bin_header(
+    void       *circuit,
+    unsigned int flags,
+    char       *bin_buffer,      unsigned long *bin_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Produces the input schema of the circuit from a complete example input.
+ */
+int
+witnesscalc_authV2_input_schema(
+    void       *circuit,
+    const char *json_buffer,     unsigned long  json_size,
+    char       *schema_buffer,   unsigned long *schema_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
+/**
+ * Checks an input schema against the circuit, once at startup.
+ */
+int
+witnesscalc_authV2_input_schema_check(
+    void       *circuit,
+    const char *schema_buffer,   unsigned long  schema_size,
+    char       *error_msg,       unsigned long  error_msg_maxsize);
+
 #ifdef __cplusplus
 }
 #endif